@@ -0,0 +1,228 @@
+// BatchSimulator.h - thousands of independent headless games stepped in
+// lock-step, for bot training and difficulty tuning on Linux.
+//
+// step() takes one action byte per game and fills, per game, an
+// observation vector, a reward and a done flag. Each call advances every
+// game by exactly one simulation tick. A game whose episode ends is
+// restarted at once from a fresh seed, and its observation is already the
+// new episode's first (done still reports the end).
+//
+// The games are built headless (HeadlessConfig below): no snapshot buffers,
+// dirty regions, HUD caches or raster, and a one-slot particle pool, since
+// particles never feed back into play. Resets and steps go through the
+// simulation alone, so after construction nothing reads the clock, a pin or
+// NVS and nothing is published; the sound calls return at once on an audio
+// engine that was never begun.
+//
+// The games live in one contiguous, cache-line aligned array and are
+// stepped in chunks of neighbouring games by a WorkStealingPool. Results
+// depend only on the seed and the actions, never on the thread count.
+#ifndef BATCH_SIMULATOR_H
+#define BATCH_SIMULATOR_H
+
+#include <Adafruit_SSD1306.h>
+#include "AstroLib.h"
+#include "WorkStealingPool.h"
+#include <limits.h>
+#include <new>
+
+// --- Actions (bits of one byte per game) ---
+const uint8_t BATCH_LEFT = 0x01;       // Full stick left
+const uint8_t BATCH_RIGHT = 0x02;      // Full stick right (LEFT wins if both)
+const uint8_t BATCH_THRUST = 0x04;     // Full stick forward
+const uint8_t BATCH_FIRE = 0x08;       // Held button: fires on the press, like the real one
+const uint8_t BATCH_HYPERSPACE = 0x10; // Held button: jumps on the press
+
+const uint32_t BATCH_EPISODE_TICKS = 30 * 60 * 5; // Default cut-off: five minutes at 30 Hz
+const int BATCH_LIFE_PENALTY = 100;               // Reward lost per life
+const int BATCH_CHUNK_GAMES = 32;                 // Neighbouring games per work item
+
+// Config as the batch builds it: the same game with the render side left out
+template <typename Config>
+struct HeadlessConfig : Config {
+    static const bool RENDERING = false;
+    static const int PARTICLE_CAPACITY = 1;
+    static const int PARTICLE_BUDGET = 1;
+};
+
+template <typename Config = DefaultConfig>
+class BatchSimulator {
+public:
+    typedef BasicAstroLib<HeadlessConfig<Config> > Game;
+
+    // Observation layout, all floats:
+    //   ship      x, y (0..1 of the screen), vx, vy (px/frame / 4),
+    //             sin, cos of heading, invincible (0/1), lives / 3,
+    //             bullets in flight / MAX_BULLETS
+    //   asteroid  per pool slot: active (0/1), dx, dy to the ship the short
+    //             way round (-1..1 of half the screen), vx, vy (px/frame / 2),
+    //             size / large size; all zero for a free slot
+    static const int OBS_SHIP = 9;
+    static const int OBS_PER_ASTEROID = 6;
+    static const int OBS_SIZE = OBS_SHIP + OBS_PER_ASTEROID * Config::MAX_ASTEROIDS;
+
+    // threads <= 0: one per hardware thread. episodeTicks 0: games end
+    // only at game over.
+    BatchSimulator(int envCount, uint32_t seed, int threads = 0, uint32_t episodeTicks = BATCH_EPISODE_TICKS)
+        : pool(threads), display(Config::WIDTH, Config::HEIGHT, &Wire, -1), envCount(envCount < 1 ? 1 : envCount),
+          baseSeed(seed), episodeLimit(episodeTicks), steps(0), jobActions(NULL), jobObservations(NULL),
+          jobRewards(NULL), jobDones(NULL)
+    {
+        games = static_cast<Game *>(::operator new(sizeof(Game) * this->envCount, std::align_val_t(64)));
+        states = new EnvState[this->envCount];
+        for (int i = 0; i < this->envCount; ++i)
+        {
+            new (&games[i]) Game(display); // Shared display: headless games never draw
+            states[i].episode = 0;
+        }
+    }
+
+    ~BatchSimulator()
+    {
+        for (int i = 0; i < envCount; ++i)
+            games[i].~Game();
+        ::operator delete(games, std::align_val_t(64));
+        delete[] states;
+    }
+
+    int size() const { return envCount; }
+    int threadCount() const { return pool.threadCount(); }
+    uint64_t totalSteps() const { return steps; } // Game ticks, summed over games
+    uint64_t stolenChunks() const { return pool.stolenChunks(); }
+
+    // Starts a new episode in every game. observations: size() * OBS_SIZE
+    void reset(float *observations)
+    {
+        jobActions = NULL;
+        jobObservations = observations;
+        pool.run(envCount, BATCH_CHUNK_GAMES, resetChunk, this);
+    }
+
+    // actions: size(); observations: size() * OBS_SIZE; rewards, dones: size()
+    void step(const uint8_t *actions, float *observations, float *rewards, uint8_t *dones)
+    {
+        jobActions = actions;
+        jobObservations = observations;
+        jobRewards = rewards;
+        jobDones = dones;
+        pool.run(envCount, BATCH_CHUNK_GAMES, stepChunk, this);
+        steps += envCount;
+    }
+
+private:
+    struct EnvState {
+        uint32_t episode;
+        uint32_t ticks; // Into the current episode
+        int score;      // At the last step, for the reward
+        int lives;
+    };
+
+    WorkStealingPool pool;
+    Adafruit_SSD1306 display;
+    Game *games;       // Contiguous, constructed in place
+    EnvState *states;  // Parallel to games
+    int envCount;
+    uint32_t baseSeed;
+    uint32_t episodeLimit;
+    uint64_t steps;
+
+    // Arguments of the run in progress
+    const uint8_t *jobActions;
+    float *jobObservations;
+    float *jobRewards;
+    uint8_t *jobDones;
+
+    static void resetChunk(void *context, int begin, int end)
+    {
+        BatchSimulator *sim = static_cast<BatchSimulator *>(context);
+        for (int i = begin; i < end; ++i)
+        {
+            sim->startEpisode(i);
+            sim->observe(i, sim->jobObservations + (size_t)i * OBS_SIZE);
+        }
+    }
+
+    static void stepChunk(void *context, int begin, int end)
+    {
+        BatchSimulator *sim = static_cast<BatchSimulator *>(context);
+        for (int i = begin; i < end; ++i)
+            sim->stepGame(i);
+    }
+
+    // Same reset as a replay, minus the clock and snapshot, then straight
+    // into play. The unbeatable high score keeps the high-score bookkeeping
+    // (and its serial log) out.
+    void startEpisode(int i)
+    {
+        Game &game = games[i];
+        EnvState &state = states[i];
+        uint32_t seed = baseSeed + (uint32_t)i * 0x9E3779B9u + state.episode * 0x85EBCA6Bu;
+        InputLogHeader header = {seed, (uint16_t)SIM_TICK_RATE, INT32_MAX};
+        game.resetSimulation(header);
+        game.currentState = GAME;
+        state.episode++;
+        state.ticks = 0;
+        state.score = game.score;
+        state.lives = game.lives;
+    }
+
+    void stepGame(int i)
+    {
+        Game &game = games[i];
+        EnvState &state = states[i];
+        uint8_t action = jobActions[i];
+        int joyX = (action & BATCH_LEFT) ? 0 : (action & BATCH_RIGHT) ? 4095 : JOYSTICK_CENTER;
+        int joyY = (action & BATCH_THRUST) ? 0 : JOYSTICK_CENTER;
+
+        // One fixed tick, as advance() runs it, minus the audio update and the snapshot
+        game.tickCount++;
+        game.stepSimulation(joyX, joyY, (action & BATCH_FIRE) != 0, (action & BATCH_HYPERSPACE) != 0);
+        state.ticks++;
+
+        jobRewards[i] = (float)(game.score - state.score) - (float)(BATCH_LIFE_PENALTY * (state.lives - game.lives));
+        state.score = game.score;
+        state.lives = game.lives;
+        bool done = game.currentState == GAME_OVER || (episodeLimit && state.ticks >= episodeLimit);
+        jobDones[i] = done;
+        if (done)
+            startEpisode(i);
+        observe(i, jobObservations + (size_t)i * OBS_SIZE);
+    }
+
+    void observe(int i, float *out) const
+    {
+        const Game &game = games[i];
+        const GameObject &ship = game.ship;
+        float shipX = toFloat(ship.pos.x), shipY = toFloat(ship.pos.y);
+        float sinA, cosA;
+        sinCos(ship.angle, sinA, cosA);
+        out[0] = shipX / Config::WIDTH;
+        out[1] = shipY / Config::HEIGHT;
+        out[2] = toFloat(ship.vel.x) * 0.25f;
+        out[3] = toFloat(ship.vel.y) * 0.25f;
+        out[4] = sinA;
+        out[5] = cosA;
+        out[6] = ship.lifetime > 0;
+        out[7] = game.lives / 3.0f;
+        out[8] = (float)game.bullets.count() / Config::MAX_BULLETS;
+
+        float *slot = out + OBS_SHIP;
+        for (int k = 0; k < Config::MAX_ASTEROIDS; ++k, slot += OBS_PER_ASTEROID)
+        {
+            if (!game.asteroids.isActive(k))
+            {
+                for (int f = 0; f < OBS_PER_ASTEROID; ++f)
+                    slot[f] = 0;
+                continue;
+            }
+            slot[0] = 1;
+            slot[1] = toFloat(toroidalDelta(game.asteroids.posX[k] - ship.pos.x, Config::WIDTH)) * (2.0f / Config::WIDTH);
+            slot[2] = toFloat(toroidalDelta(game.asteroids.posY[k] - ship.pos.y, Config::HEIGHT)) * (2.0f / Config::HEIGHT);
+            slot[3] = toFloat(game.asteroids.velX[k]) * 0.5f;
+            slot[4] = toFloat(game.asteroids.velY[k]) * 0.5f;
+            slot[5] = (float)game.asteroids.size[k] / ASTEROID_SIZE_LARGE;
+        }
+    }
+};
+
+#endif // BATCH_SIMULATOR_H
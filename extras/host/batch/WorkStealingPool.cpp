@@ -0,0 +1,139 @@
+#include "WorkStealingPool.h"
+
+static int resolveThreads(int threads)
+{
+    if (threads <= 0)
+        threads = (int)std::thread::hardware_concurrency();
+    return threads > 0 ? threads : 1;
+}
+
+WorkStealingPool::WorkStealingPool(int threads)
+    : blocks(resolveThreads(threads)), jobFn(NULL), jobContext(NULL), jobCount(0), jobChunk(1), generation(0),
+      remainingChunks(0), stolen(0), stopping(false)
+{
+    for (size_t i = 0; i < blocks.size(); ++i)
+        blocks[i].range.store(0, std::memory_order_relaxed);
+    for (int i = 1; i < threadCount(); ++i) // Thread 0 is whoever calls run()
+        workers.push_back(std::thread(&WorkStealingPool::workerLoop, this, i));
+}
+
+WorkStealingPool::~WorkStealingPool()
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+        generation.fetch_add(1, std::memory_order_release);
+    }
+    wake.notify_all();
+    for (size_t i = 0; i < workers.size(); ++i)
+        workers[i].join();
+}
+
+void WorkStealingPool::run(int count, int chunkSize, ChunkFn fn, void *context)
+{
+    if (count <= 0)
+        return;
+    if (chunkSize < 1)
+        chunkSize = 1;
+    int chunks = (count + chunkSize - 1) / chunkSize;
+    int threads = threadCount();
+    uint32_t tag = generation.load(std::memory_order_relaxed) + 1;
+
+    jobFn = fn;
+    jobContext = context;
+    jobCount = count;
+    jobChunk = chunkSize;
+    remainingChunks.store(chunks, std::memory_order_relaxed);
+    for (int t = 0; t < threads; ++t)
+    {
+        uint32_t first = (uint32_t)((int64_t)chunks * t / threads);
+        uint32_t end = (uint32_t)((int64_t)chunks * (t + 1) / threads);
+        blocks[t].range.store(packRange(tag, first, end), std::memory_order_relaxed);
+    }
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        generation.store(tag, std::memory_order_release); // Publishes the job and the blocks
+    }
+    wake.notify_all();
+
+    work(0, tag);
+    while (remainingChunks.load(std::memory_order_acquire) > 0)
+        std::this_thread::yield(); // Chunks still running on other threads
+}
+
+void WorkStealingPool::workerLoop(int self)
+{
+    uint32_t seen = 0;
+    for (;;)
+    {
+        // Poll for a while so back-to-back runs skip the sleep/wake round trip
+        uint32_t tag = generation.load(std::memory_order_acquire);
+        for (int spin = 0; tag == seen && spin < SPIN_LIMIT; ++spin)
+        {
+            std::this_thread::yield();
+            tag = generation.load(std::memory_order_acquire);
+        }
+        if (tag == seen)
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            wake.wait(lock, [&] { return generation.load(std::memory_order_relaxed) != seen || stopping; });
+            tag = generation.load(std::memory_order_relaxed);
+        }
+        if (stopping)
+            return;
+        seen = tag;
+        work(self, tag);
+    }
+}
+
+void WorkStealingPool::work(int self, uint32_t tag)
+{
+    int chunk;
+    while (takeFront(self, tag, chunk) || stealBack(self, tag, chunk))
+    {
+        int begin = chunk * jobChunk;
+        int end = (begin + jobChunk < jobCount) ? begin + jobChunk : jobCount;
+        jobFn(jobContext, begin, end);
+        remainingChunks.fetch_sub(1, std::memory_order_release);
+    }
+}
+
+bool WorkStealingPool::takeFront(int self, uint32_t tag, int &chunk)
+{
+    std::atomic<uint64_t> &range = blocks[self].range;
+    uint64_t word = range.load(std::memory_order_acquire);
+    for (;;)
+    {
+        uint32_t first = (uint32_t)(word >> 24) & 0xFFFFFF, end = (uint32_t)word & 0xFFFFFF;
+        if ((uint32_t)(word >> 48) != (tag & 0xFFFF) || first >= end)
+            return false;
+        if (range.compare_exchange_weak(word, packRange(tag, first + 1, end), std::memory_order_acq_rel))
+        {
+            chunk = (int)first;
+            return true;
+        }
+    }
+}
+
+bool WorkStealingPool::stealBack(int self, uint32_t tag, int &chunk)
+{
+    int threads = threadCount();
+    for (int k = 1; k < threads; ++k)
+    {
+        std::atomic<uint64_t> &range = blocks[(self + k) % threads].range;
+        uint64_t word = range.load(std::memory_order_acquire);
+        for (;;)
+        {
+            uint32_t first = (uint32_t)(word >> 24) & 0xFFFFFF, end = (uint32_t)word & 0xFFFFFF;
+            if ((uint32_t)(word >> 48) != (tag & 0xFFFF) || first >= end)
+                break; // Empty: try the next victim
+            if (range.compare_exchange_weak(word, packRange(tag, first, end - 1), std::memory_order_acq_rel))
+            {
+                chunk = (int)end - 1;
+                stolen.fetch_add(1, std::memory_order_relaxed);
+                return true;
+            }
+        }
+    }
+    return false;
+}
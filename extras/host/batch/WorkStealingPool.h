@@ -0,0 +1,68 @@
+// WorkStealingPool.h - persistent worker threads for lock-step batch work.
+// run() splits [0, count) into chunks and deals them out as one contiguous
+// block per thread, so each thread starts on its own stretch of memory.
+// A thread that empties its block steals single chunks from the back of
+// the others'. The calling thread works as well, and run() returns only
+// once every chunk has finished.
+//
+// Each block is one 64-bit word (run tag, first chunk, end chunk) changed
+// by compare-and-swap only: the owner takes from the front, thieves from
+// the back, and the tag stops a thread that wakes late from taking a
+// chunk of a later run.
+#ifndef WORK_STEALING_POOL_H
+#define WORK_STEALING_POOL_H
+
+#include <stdint.h>
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+class WorkStealingPool {
+public:
+    // Runs items [begin, end) of the current job
+    typedef void (*ChunkFn)(void *context, int begin, int end);
+
+    // threads <= 0: one per hardware thread. Includes the caller of run().
+    explicit WorkStealingPool(int threads = 0);
+    ~WorkStealingPool();
+
+    int threadCount() const { return (int)blocks.size(); }
+    void run(int count, int chunkSize, ChunkFn fn, void *context);
+    uint64_t stolenChunks() const { return stolen.load(std::memory_order_relaxed); }
+
+private:
+    static const int SPIN_LIMIT = 20000; // Idle polls before a worker sleeps
+
+    struct alignas(64) Block {
+        std::atomic<uint64_t> range; // tag << 48 | first << 24 | end
+    };
+
+    std::vector<Block> blocks;
+    std::vector<std::thread> workers;
+
+    // Current job; written by run() while no chunk is outstanding
+    ChunkFn jobFn;
+    void *jobContext;
+    int jobCount;
+    int jobChunk;
+    std::atomic<uint32_t> generation;   // Bumped once per run()
+    std::atomic<int> remainingChunks;
+    std::atomic<uint64_t> stolen;
+    std::atomic<bool> stopping;
+    std::mutex mutex;
+    std::condition_variable wake;
+
+    void workerLoop(int self);
+    void work(int self, uint32_t tag);
+    bool takeFront(int self, uint32_t tag, int &chunk);
+    bool stealBack(int self, uint32_t tag, int &chunk);
+
+    static uint64_t packRange(uint32_t tag, uint32_t first, uint32_t end)
+    {
+        return ((uint64_t)(tag & 0xFFFF) << 48) | ((uint64_t)first << 24) | end;
+    }
+};
+
+#endif // WORK_STEALING_POOL_H
@@ -0,0 +1,186 @@
+// bench_audio.cpp - AudioEngine sequencer behaviour and timing, read back
+// from the host tone() log.
+// 1. Polled on a simulated clock: voice priorities (a shot interrupts
+//    thrust, thrust resumes), the hyperspace and explosion sweeps, and
+//    stopAllSounds().
+// 2. Timer-driven on its own thread: how long after a play call the tone
+//    starts, and how close a 50 ms shot comes to 50 ms, compared with
+//    polling from a 30 Hz game loop.
+//
+// Usage: bench_audio [shots]
+
+#include <Arduino.h>
+#include "AudioEngine.h"
+#include <chrono>
+#include <stdio.h>
+#include <thread>
+#include <vector>
+
+const uint8_t BUZZER_PIN = 25;
+
+static unsigned long simMillis = 0;
+static unsigned long simClock() { return simMillis; }
+
+static bool failed = false;
+
+static void check(bool ok, const char *what)
+{
+    printf("  %-58s %s\n", what, ok ? "ok" : "FAIL");
+    failed = failed || !ok;
+}
+
+// Frequencies emitted since the last call, in order
+static std::vector<unsigned int> drainFrequencies()
+{
+    std::vector<HostToneEvent> events = hostToneEvents();
+    hostClearToneEvents();
+    std::vector<unsigned int> freqs;
+    for (size_t i = 0; i < events.size(); ++i)
+        freqs.push_back(events[i].frequency);
+    return freqs;
+}
+
+static void advance(AudioEngine &audio, unsigned long ms)
+{
+    for (unsigned long i = 0; i < ms; ++i)
+    {
+        simMillis++;
+        audio.update();
+    }
+}
+
+static void polledChecks()
+{
+    printf("polled sequencer, simulated 1 ms steps:\n");
+    AudioEngine audio;
+    audio.attachTimeSource(simClock);
+    audio.begin(BUZZER_PIN);
+    hostClearToneEvents();
+
+    audio.startThrustSound(1.0f);
+    advance(audio, 20);
+    audio.playShootSound();
+    advance(audio, 100);
+    std::vector<unsigned int> f = drainFrequencies();
+    check(f.size() == 3 && f[0] == SND_THRUST_FREQ_HIGH && f[1] == SND_SHOOT_FREQ && f[2] == SND_THRUST_FREQ_HIGH,
+          "shot interrupts thrust, thrust resumes afterwards");
+
+    audio.playHyperspaceSound();
+    advance(audio, SND_HYPERSPACE_DURATION + 10);
+    f = drainFrequencies();
+    bool falling = f.size() > 2 && f[0] == SND_HYPERSPACE_FREQ && f.back() == SND_THRUST_FREQ_HIGH;
+    for (size_t i = 1; falling && i + 1 < f.size(); ++i)
+        falling = f[i] < f[i - 1] && f[i] >= SND_HYPERSPACE_END_FREQ;
+    char label[96];
+    snprintf(label, sizeof(label), "hyperspace sweeps %u -> %u Hz in %zu steps", f.empty() ? 0 : f[0],
+             f.size() > 1 ? f[f.size() - 2] : 0, f.size() - 1);
+    check(falling && f.size() - 1 == SND_HYPERSPACE_DURATION / SND_SWEEP_STEP, label);
+
+    audio.playExplosionSound();
+    advance(audio, 10);
+    audio.playShootSound(); // Lower priority: hidden under the explosion
+    advance(audio, SND_SHORT_DURATION * 2);
+    f = drainFrequencies();
+    bool hidden = !f.empty() && f[0] == SND_EXPLODE_FREQ && f.back() == SND_THRUST_FREQ_HIGH;
+    for (size_t i = 0; i < f.size(); ++i)
+        hidden = hidden && f[i] != SND_SHOOT_FREQ;
+    check(hidden, "shot under an explosion stays hidden");
+
+    audio.stopAllSounds();
+    advance(audio, 1);
+    f = drainFrequencies();
+    check(f.size() == 1 && f[0] == 0, "stopAllSounds() silences the buzzer");
+
+    audio.startThrustSound(0.0f);
+    audio.playShootSound();
+    simMillis += 33; // One 30 Hz frame in a single update()
+    audio.update();
+    f = drainFrequencies();
+    check(f.size() == 1 && f[0] == SND_SHOOT_FREQ, "a sound queued mid-frame still plays at full length");
+    audio.stopAllSounds();
+    advance(audio, 1);
+}
+
+struct Timing {
+    double meanLatencyUs, maxLatencyUs;
+    double meanLengthErrUs, maxLengthErrUs;
+};
+
+// Shot onset latency and length, measured from the tone log timestamps
+static Timing timedShots(AudioEngine &audio, int shots, bool polled30Hz)
+{
+    Timing t = {0, 0, 0, 0};
+    unsigned long frameStart = micros();
+    for (int s = 0; s < shots; ++s)
+    {
+        hostClearToneEvents();
+        // Trigger at an arbitrary point inside a frame, as handleCollisions() would
+        std::this_thread::sleep_for(std::chrono::microseconds(1000 + (s * 7919) % 20000));
+        unsigned long requested = micros();
+        frameStart = requested - (requested - frameStart) % 33333; // The loop kept running meanwhile
+        audio.playShootSound();
+        unsigned long until = requested + (SND_SHORT_DURATION + 80) * 1000;
+        while (micros() < until)
+        {
+            if (polled30Hz)
+            {
+                frameStart += 33333;
+                while (micros() < frameStart)
+                    std::this_thread::sleep_for(std::chrono::microseconds(200));
+                audio.update();
+            }
+            else
+                std::this_thread::sleep_for(std::chrono::milliseconds(5));
+        }
+        std::vector<HostToneEvent> events = hostToneEvents();
+        if (events.size() < 2 || events[0].frequency != SND_SHOOT_FREQ)
+        {
+            t.maxLatencyUs = 1e9; // Never played
+            continue;
+        }
+        double latency = (double)(events[0].micros - requested);
+        double lengthErr = fabs((double)(events[1].micros - events[0].micros) - SND_SHORT_DURATION * 1000.0);
+        t.meanLatencyUs += latency / shots;
+        t.maxLatencyUs = fmax(t.maxLatencyUs, latency);
+        t.meanLengthErrUs += lengthErr / shots;
+        t.maxLengthErrUs = fmax(t.maxLengthErrUs, lengthErr);
+    }
+    return t;
+}
+
+int main(int argc, char **argv)
+{
+    int shots = (argc > 1) ? atoi(argv[1]) : 24;
+    if (shots <= 0)
+        shots = 1;
+
+    polledChecks();
+
+    printf("real-time shots (%d each):\n", shots);
+    AudioEngine polled;
+    polled.begin(BUZZER_PIN);
+    Timing p = timedShots(polled, shots, true);
+
+    AudioEngine timed;
+    timed.begin(BUZZER_PIN);
+    bool started = timed.startTimer();
+    Timing t = timedShots(timed, shots, false);
+    // The last shot ended well before timedShots() returned: the timer should be idle
+    uint32_t idleSteps = timed.hostStepCount();
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    idleSteps = timed.hostStepCount() - idleSteps;
+    hostClearToneEvents();
+    timed.playShootSound();
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    bool rearmed = !hostToneEvents().empty() && hostToneEvents()[0].frequency == SND_SHOOT_FREQ;
+    timed.stopTimer();
+
+    printf("  polled at 30 Hz:   onset %7.0f us mean %7.0f us max, length error %7.0f us mean %7.0f us max\n",
+           p.meanLatencyUs, p.maxLatencyUs, p.meanLengthErrUs, p.maxLengthErrUs);
+    printf("  1 ms timer thread: onset %7.0f us mean %7.0f us max, length error %7.0f us mean %7.0f us max\n",
+           t.meanLatencyUs, t.maxLatencyUs, t.meanLengthErrUs, t.maxLengthErrUs);
+    check(started && t.maxLatencyUs < 1e9 && t.meanLatencyUs < p.meanLatencyUs,
+          "timer-driven onset beats polling from the game loop");
+    check(idleSteps == 0 && rearmed, "the timer stops while silent and restarts on the next sound");
+    return failed ? 1 : 0;
+}
@@ -0,0 +1,130 @@
+// bench_batch.cpp - BatchSimulator throughput and core scaling.
+// Steps a batch of headless games in lock-step under random play with 1, 2,
+// 4, ... threads up to the hardware count (or the --threads list), and
+// reports environment steps per second, the speed-up over one thread and
+// the chunks stolen. Every thread count must produce exactly the same
+// observations, rewards and done flags.
+//
+// Usage: bench_batch [games] [steps] [--threads 1,2,8]
+
+#include "BatchSimulator.h"
+#include <chrono>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <string>
+#include <thread>
+#include <vector>
+
+typedef std::chrono::steady_clock Clock;
+
+struct BatchResult {
+    double stepsPerSecond;
+    uint32_t checksum;
+    long episodesEnded;
+    uint64_t stolen;
+};
+
+// FNV-1a over raw bytes
+static uint32_t hashBytes(uint32_t h, const void *data, size_t length)
+{
+    const uint8_t *bytes = static_cast<const uint8_t *>(data);
+    for (size_t i = 0; i < length; ++i)
+        h = (h ^ bytes[i]) * 16777619u;
+    return h;
+}
+
+static BatchResult runBatch(int games, int steps, int threads)
+{
+    typedef BatchSimulator<DefaultConfig> Sim;
+    Sim sim(games, 7, threads);
+    std::vector<float> observations((size_t)games * Sim::OBS_SIZE);
+    std::vector<float> rewards(games);
+    std::vector<uint8_t> dones(games);
+    std::vector<uint8_t> actions(games);
+    std::vector<uint32_t> policy(games);
+    for (int i = 0; i < games; ++i)
+        policy[i] = 0x1234567u + i * 2654435761u;
+
+    sim.reset(observations.data());
+    BatchResult result = {0, 2166136261u, 0, 0};
+    double seconds = 0;
+    for (int s = 0; s < steps; ++s)
+    {
+        // Random stick, fire pressed every other tick (untimed)
+        for (int i = 0; i < games; ++i)
+        {
+            policy[i] = policy[i] * 1664525u + 1013904223u;
+            uint8_t stick = (uint8_t)((policy[i] >> 24) & (BATCH_LEFT | BATCH_RIGHT | BATCH_THRUST));
+            uint8_t jump = ((policy[i] >> 16) & 0xFF) == 0 ? BATCH_HYPERSPACE : 0;
+            actions[i] = stick | jump | ((s & 1) ? BATCH_FIRE : 0);
+        }
+        Clock::time_point t0 = Clock::now();
+        sim.step(actions.data(), observations.data(), rewards.data(), dones.data());
+        seconds += std::chrono::duration<double>(Clock::now() - t0).count();
+
+        result.checksum = hashBytes(result.checksum, observations.data(), observations.size() * sizeof(float));
+        result.checksum = hashBytes(result.checksum, rewards.data(), rewards.size() * sizeof(float));
+        result.checksum = hashBytes(result.checksum, dones.data(), dones.size());
+        for (int i = 0; i < games; ++i)
+            result.episodesEnded += dones[i];
+    }
+    result.stepsPerSecond = (double)games * steps / seconds;
+    result.stolen = sim.stolenChunks();
+    return result;
+}
+
+int main(int argc, char **argv)
+{
+    int games = 4096, steps = 300;
+    std::vector<int> threadCounts;
+    int positional = 0;
+    for (int i = 1; i < argc; ++i)
+    {
+        if (!strcmp(argv[i], "--threads") && i + 1 < argc)
+        {
+            char *list = argv[++i], *end;
+            for (long t = strtol(list, &end, 10); end != list; t = strtol(list, &end, 10))
+            {
+                threadCounts.push_back(max(1, (int)t));
+                list = (*end == ',') ? end + 1 : end;
+            }
+        }
+        else if (positional++ == 0)
+            games = max(1, atoi(argv[i]));
+        else
+            steps = max(1, atoi(argv[i]));
+    }
+    int hardware = max(1, (int)std::thread::hardware_concurrency());
+    if (threadCounts.empty())
+    {
+        for (int t = 1; t < hardware; t *= 2)
+            threadCounts.push_back(t);
+        threadCounts.push_back(hardware);
+    }
+
+    printf("%d games x %d steps, %d hardware threads, %d floats per observation\n", games, steps, hardware,
+           BatchSimulator<DefaultConfig>::OBS_SIZE);
+    bool ok = true;
+    double perThread = 0; // First run's rate per thread: the linear-scaling yardstick
+    uint32_t reference = 0;
+    for (size_t k = 0; k < threadCounts.size(); ++k)
+    {
+        int threads = threadCounts[k];
+        BatchResult r = runBatch(games, steps, threads);
+        if (k == 0)
+        {
+            perThread = r.stepsPerSecond / threads;
+            reference = r.checksum;
+        }
+        bool same = r.checksum == reference;
+        ok = ok && same;
+        double speedup = r.stepsPerSecond / perThread;
+        printf("threads %3d  %12.0f env-steps/s  speed-up %5.2fx (%3.0f%% of linear)  episodes ended %6ld  "
+               "stolen chunks %6llu  results %s\n",
+               threads, r.stepsPerSecond, speedup, 100.0 * speedup / threads, r.episodesEnded,
+               (unsigned long long)r.stolen, same ? "identical" : "DIFFER");
+    }
+    printf("%s\n", ok ? "ok" : "FAILED");
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,126 @@
+// bench_collide.cpp - CollisionGrid broad phase vs the brute-force scan.
+// For every probe (a bullet) both sides find the lowest asteroid slot it
+// overlaps. Scenes confined to less than half the screen never wrap, so
+// there the grid must agree with the old non-wrapping scan exactly;
+// full-screen scenes are checked against a wrap-aware scan and timed.
+//
+// Usage: bench_collide [rounds]
+
+#include "CollisionGrid.h"
+#include <chrono>
+#include <stdio.h>
+
+typedef std::chrono::steady_clock Clock;
+
+static uint32_t seed = 0x5EEDu;
+
+static int nextRandom(int range)
+{
+    seed = seed * 1664525u + 1013904223u;
+    return (int)((seed >> 8) % (uint32_t)range);
+}
+
+template <int Capacity>
+static int bruteFirstHit(const EntityPool<Capacity> &pool, Scalar x, Scalar y, Scalar radius, bool wrap)
+{
+    for (int j = pool.first(); j >= 0; j = pool.next(j))
+    {
+        Scalar dx = x - pool.posX[j];
+        Scalar dy = y - pool.posY[j];
+        if (wrap)
+        {
+            dx = toroidalDelta(dx, SCREEN_WIDTH);
+            dy = toroidalDelta(dy, SCREEN_HEIGHT);
+        }
+        if (circlesOverlap(dx, dy, radius + pool.radius[j]))
+            return j;
+    }
+    return -1;
+}
+
+// Fills the pool with asteroids inside [x0, x0 + w) x [y0, y0 + h)
+template <int Capacity>
+static void fillScene(EntityPool<Capacity> &pool, int count, int x0, int y0, int w, int h)
+{
+    static const int sizes[3] = {ASTEROID_SIZE_LARGE, ASTEROID_SIZE_MEDIUM, ASTEROID_SIZE_SMALL};
+    pool.clear();
+    for (int n = 0; n < count; ++n)
+    {
+        int slot = pool.allocate();
+        pool.posX[slot] = x0 + nextRandom(w * 16) / 16.0f;
+        pool.posY[slot] = y0 + nextRandom(h * 16) / 16.0f;
+        pool.radius[slot] = sizes[nextRandom(3)];
+    }
+}
+
+template <int Capacity>
+static bool compare(long rounds)
+{
+    static EntityPool<Capacity> pool;
+    static CollisionGrid<Capacity> grid;
+    const int asteroids = Capacity;
+    const int probes = Capacity / 2 > 4 ? Capacity / 2 : 4;
+    Scalar probeX[Capacity], probeY[Capacity];
+    long mismatches = 0;
+
+    // --- Correctness: non-wrapping scenes match the old scan ---
+    for (int scene = 0; scene < 200; ++scene)
+    {
+        fillScene(pool, asteroids, 8, 8, SCREEN_WIDTH / 2 - 16, SCREEN_HEIGHT / 2 - 16);
+        grid.build(pool);
+        for (int p = 0; p < probes; ++p)
+        {
+            Scalar x = 8 + nextRandom((SCREEN_WIDTH / 2 - 16) * 16) / 16.0f;
+            Scalar y = 8 + nextRandom((SCREEN_HEIGHT / 2 - 16) * 16) / 16.0f;
+            mismatches += grid.firstHit(pool, x, y, BULLET_COLLISION_RADIUS) != bruteFirstHit(pool, x, y, (Scalar)BULLET_COLLISION_RADIUS, false);
+        }
+    }
+
+    // --- Full-screen scene, wrap-aware on both sides ---
+    fillScene(pool, asteroids, 0, 0, SCREEN_WIDTH, SCREEN_HEIGHT);
+    for (int p = 0; p < probes; ++p)
+    {
+        probeX[p] = nextRandom(SCREEN_WIDTH * 16) / 16.0f;
+        probeY[p] = nextRandom(SCREEN_HEIGHT * 16) / 16.0f;
+    }
+    grid.build(pool);
+    for (int p = 0; p < probes; ++p)
+        mismatches += grid.firstHit(pool, probeX[p], probeY[p], BULLET_COLLISION_RADIUS) != bruteFirstHit(pool, probeX[p], probeY[p], (Scalar)BULLET_COLLISION_RADIUS, true);
+
+    long hits = 0;
+    Clock::time_point t0 = Clock::now();
+    for (long r = 0; r < rounds; ++r)
+    {
+        asm volatile("" ::: "memory"); // Keep the scene from being treated as loop-invariant
+        for (int p = 0; p < probes; ++p)
+            hits += bruteFirstHit(pool, probeX[p], probeY[p], (Scalar)BULLET_COLLISION_RADIUS, true) >= 0;
+    }
+    Clock::time_point t1 = Clock::now();
+    for (long r = 0; r < rounds; ++r)
+    {
+        grid.build(pool); // Rebuild cost is part of every frame
+        for (int p = 0; p < probes; ++p)
+            hits -= grid.firstHit(pool, probeX[p], probeY[p], BULLET_COLLISION_RADIUS) >= 0;
+    }
+    Clock::time_point t2 = Clock::now();
+
+    double bruteNs = std::chrono::duration<double, std::nano>(t1 - t0).count() / rounds;
+    double gridNs = std::chrono::duration<double, std::nano>(t2 - t1).count() / rounds;
+    bool ok = mismatches == 0 && hits == 0;
+    printf("asteroids %4d  bullets %4d   brute: %9.1f ns/frame   grid: %9.1f ns/frame  (%.1fx)%s\n",
+           asteroids, probes, bruteNs, gridNs, bruteNs / gridNs, ok ? "" : "  RESULT MISMATCH");
+    return ok;
+}
+
+int main(int argc, char **argv)
+{
+    long rounds = (argc > 1) ? atol(argv[1]) : 20000;
+    if (rounds <= 0)
+        rounds = 1;
+
+    bool ok = compare<MAX_ASTEROIDS>(rounds);
+    ok &= compare<64>(rounds);
+    ok &= compare<256>(rounds / 4 + 1);
+    ok &= compare<1024>(rounds / 16 + 1);
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,92 @@
+// bench_configs.cpp - The same scripted session on several BasicAstroLib
+// configurations: the 128x64 default, a 128x32 panel and the high-density
+// pools. Each one is recorded, then replayed into a fresh instance of the
+// same configuration, which must end on the recorded checksum. Reports the
+// instance size and the update/draw cost per frame.
+//
+// Usage: bench_configs [frames]
+
+#include <Wire.h>
+#include <Adafruit_SSD1306.h>
+#include "AstroLib.h"
+#include <chrono>
+#include <stdio.h>
+#include <stdlib.h>
+#include <vector>
+
+typedef std::chrono::steady_clock Clock;
+
+static unsigned long simMillis = 0;
+static unsigned long simClock() { return simMillis; }
+
+// Sweeps the stick and holds fire half the time, restarting after each game
+static void scriptedFrame(uint32_t f, int &joyX, int &joyY, bool &fire)
+{
+    uint32_t h = (f / 24 + 1) * 2654435761u;
+    h ^= h >> 15;
+    joyX = (int)(h % 4096);
+    joyY = (int)((h >> 12) % 4096);
+    fire = (f % 6) < 3;
+}
+
+template <typename Config>
+static bool runConfig(const char *name, uint32_t frames)
+{
+    Adafruit_SSD1306 display(Config::WIDTH, Config::HEIGHT, &Wire, -1);
+    display.begin(SSD1306_SWITCHCAPVCC, 0x3C);
+    simMillis = 0;
+
+    BasicAstroLib<Config> game(display);
+    game.attachTimeSource(simClock);
+    game.begin(25);
+
+    std::vector<uint8_t> buffer(frames * 4 + 64);
+    InputLogWriter writer(buffer.data(), buffer.size());
+    game.startRecording(writer, 1234);
+
+    double updateNs = 0, drawNs = 0;
+    int bestScore = 0;
+    for (uint32_t f = 0; f < frames; ++f)
+    {
+        int joyX, joyY;
+        bool fire;
+        scriptedFrame(f, joyX, joyY, fire);
+        simMillis += 33;
+        Clock::time_point t0 = Clock::now();
+        game.update(joyX, joyY, fire);
+        Clock::time_point t1 = Clock::now();
+        game.draw();
+        Clock::time_point t2 = Clock::now();
+        updateNs += std::chrono::duration<double, std::nano>(t1 - t0).count();
+        drawNs += std::chrono::duration<double, std::nano>(t2 - t1).count();
+        bestScore = max(bestScore, game.getScore());
+    }
+    game.stopRecording();
+    uint32_t recorded = game.stateChecksum();
+
+    Adafruit_SSD1306 display2(Config::WIDTH, Config::HEIGHT, &Wire, -1);
+    display2.begin(SSD1306_SWITCHCAPVCC, 0x3C);
+    BasicAstroLib<Config> replayed(display2);
+    replayed.begin(25);
+    InputLogReader reader(buffer.data(), writer.size());
+    bool ok = !writer.overflowed() && replayed.startReplay(reader);
+    while (ok && replayed.replayFrame())
+        replayed.draw();
+    ok = ok && reader.hasChecksum() && replayed.stateChecksum() == recorded;
+
+    printf("%-10s %3dx%-3d bullets %2d asteroids %2d particles %3d  %6zu bytes  update %7.1f ns  draw %7.1f ns  "
+           "best score %5d  replay %s\n",
+           name, Config::WIDTH, Config::HEIGHT, Config::MAX_BULLETS, Config::MAX_ASTEROIDS, Config::PARTICLE_CAPACITY,
+           sizeof(game), updateNs / frames, drawNs / frames, bestScore, ok ? "ok" : "MISMATCH");
+    return ok;
+}
+
+int main(int argc, char **argv)
+{
+    uint32_t frames = (argc > 1) ? (uint32_t)max(1L, atol(argv[1])) : 30000;
+    bool ok = runConfig<DefaultConfig>("128x64", frames);
+    ok = runConfig<Oled128x32Config>("128x32", frames) && ok;
+    ok = runConfig<DenseConfig>("dense", frames) && ok;
+    printf("%s\n", ok ? "ok" : "FAILED");
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,108 @@
+// bench_frames.cpp - headless frames-per-second benchmark for AstroLib.
+// Drives update()/draw() from a simulated 30 FPS clock with scripted
+// joystick input and reports the cost of each half of the frame, and any
+// heap allocation made while drawing (the HUD must not allocate).
+//
+// Usage: bench_frames [frames] [partial|full]
+
+#include <Wire.h>
+#include <Adafruit_SSD1306.h>
+#include "AstroLib.h"
+#include <chrono>
+#include <new>
+#include <stdio.h>
+#include <stdlib.h>
+
+// --- Allocation counter ---
+static long allocations = 0;
+
+void *operator new(size_t size)
+{
+    allocations++;
+    void *p = malloc(size ? size : 1);
+    if (!p)
+        throw std::bad_alloc();
+    return p;
+}
+void operator delete(void *p) noexcept { free(p); }
+void operator delete(void *p, size_t) noexcept { free(p); }
+
+static unsigned long simMillis = 0;
+static unsigned long simClock() { return simMillis; }
+
+int main(int argc, char **argv)
+{
+    long frames = (argc > 1) ? atol(argv[1]) : 200000;
+    if (frames <= 0)
+        frames = 1;
+    bool fullFlush = (argc > 2) && strcmp(argv[2], "full") == 0;
+
+    Adafruit_SSD1306 display(SCREEN_WIDTH, SCREEN_HEIGHT, &Wire, -1);
+    display.begin(SSD1306_SWITCHCAPVCC, 0x3C);
+    randomSeed(12345);
+
+    AstroLib game(display);
+    game.attachTimeSource(simClock);
+    game.begin(25);
+    if (!fullFlush)
+        game.attachPartialFlush(Wire, 0x3C);
+
+    typedef std::chrono::steady_clock Clock;
+    Clock::duration updateTime(0), drawTime(0), worstUpdate(0);
+    uint32_t script = 0x1234567u; // LCG driving the joystick
+    int joyX = JOYSTICK_CENTER, joyY = JOYSTICK_CENTER;
+    long gamesStarted = 0;
+    long wavesCleared = 0;
+    long panelMismatches = 0; // Frames where the panel would not show the framebuffer
+    long drawAllocations = 0;
+
+    for (long f = 0; f < frames; ++f)
+    {
+        simMillis += 33;
+        if ((f & 15) == 0)
+        {
+            script = script * 1664525u + 1013904223u;
+            joyX = (int)((script >> 8) % 4096);
+            joyY = (int)((script >> 20) % 4096);
+        }
+        bool fire = (f & 1) != 0;
+        if (game.getCurrentState() == START && fire)
+            gamesStarted++;
+
+        GameState before = game.getCurrentState();
+        Clock::time_point t0 = Clock::now();
+        game.update(joyX, joyY, fire);
+        Clock::time_point t1 = Clock::now();
+        if (before != WAVE_CLEAR && game.getCurrentState() == WAVE_CLEAR)
+            wavesCleared++;
+        if (t1 - t0 > worstUpdate)
+            worstUpdate = t1 - t0;
+        long allocationsBefore = allocations;
+        game.draw();
+        Clock::time_point t2 = Clock::now();
+        drawAllocations += allocations - allocationsBefore;
+        updateTime += t1 - t0;
+        drawTime += t2 - t1;
+        if (!display.panelMatchesBuffer())
+            panelMismatches++;
+    }
+
+    double updateNs = std::chrono::duration<double, std::nano>(updateTime).count() / frames;
+    double drawNs = std::chrono::duration<double, std::nano>(drawTime).count() / frames;
+#if defined(ASTRO_FIXED_POINT)
+    const char *mode = "fixed Q16.16";
+#else
+    const char *mode = "float";
+#endif
+    printf("physics: %s\n", mode);
+    printf("frames: %ld  games: %ld  waves cleared: %ld  final score: %d\n", frames, gamesStarted, wavesCleared, game.getScore());
+    printf("update: %9.1f ns/frame (worst %.1f us)\n", updateNs,
+           std::chrono::duration<double, std::micro>(worstUpdate).count());
+    printf("draw:   %9.1f ns/frame\n", drawNs);
+    printf("total:  %9.0f frames/s\n", 1e9 / (updateNs + drawNs));
+    printf("i2c:    %9.1f bytes/frame (%s flush)\n", (double)Wire.bytesWritten() / frames,
+           fullFlush ? "full" : "partial");
+    printf("panel mismatches: %ld\n", panelMismatches);
+    printf("heap allocations in draw(): %ld\n", drawAllocations);
+    return (panelMismatches == 0 && drawAllocations == 0) ? 0 : 1;
+}
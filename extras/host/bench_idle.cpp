@@ -0,0 +1,107 @@
+// bench_idle.cpp - Cost of sitting on the START and GAME_OVER screens.
+// Idles on the menu, plays a hands-off game until it is over, then idles
+// on the game-over screen, with both full and partial flushing. Reports
+// draw() cost and I2C traffic per idle frame. A static screen must be sent
+// once and then never again, and the panel must keep showing the
+// framebuffer throughout.
+//
+// Usage: bench_idle [idle seconds]
+
+#include <Adafruit_SSD1306.h>
+#include "AstroLib.h"
+#include <chrono>
+#include <stdio.h>
+#include <stdlib.h>
+
+typedef std::chrono::steady_clock Clock;
+
+static unsigned long simMillis = 0;
+static unsigned long simClock() { return simMillis; }
+
+struct IdleResult {
+    double drawNs;      // Per frame
+    double bytesPerFrame;
+    unsigned long pushes; // display() calls
+    bool panelOk;
+};
+
+static IdleResult idle(AstroLib &game, Adafruit_SSD1306 &display, long frames)
+{
+    unsigned long bytesBefore = Wire.bytesWritten();
+    unsigned long pushesBefore = display.framesPushed();
+    Clock::duration drawTime(0);
+    bool panelOk = true;
+    for (long f = 0; f < frames; ++f)
+    {
+        simMillis += 33;
+        game.update(JOYSTICK_CENTER, JOYSTICK_CENTER, false);
+        Clock::time_point t0 = Clock::now();
+        game.draw();
+        drawTime += Clock::now() - t0;
+        panelOk = panelOk && display.panelMatchesBuffer();
+    }
+    IdleResult r;
+    r.drawNs = std::chrono::duration<double, std::nano>(drawTime).count() / frames;
+    r.bytesPerFrame = (double)(Wire.bytesWritten() - bytesBefore) / frames;
+    r.pushes = display.framesPushed() - pushesBefore;
+    r.panelOk = panelOk;
+    return r;
+}
+
+static bool report(const char *label, const IdleResult &r, long frames)
+{
+    // At most the first frame of the stretch goes to the panel (a whole
+    // screen, plus the addressing and control bytes of a windowed flush)
+    bool ok = r.panelOk && r.bytesPerFrame * frames <= 2 * SCREEN_WIDTH * SCREEN_HEIGHT / 8;
+    printf("%-22s draw %7.1f ns/frame  i2c %7.2f bytes/frame  display() calls %lu  %s\n", label, r.drawNs,
+           r.bytesPerFrame, r.pushes, ok ? "ok" : (r.panelOk ? "RESENT" : "PANEL MISMATCH"));
+    return ok;
+}
+
+int main(int argc, char **argv)
+{
+    long seconds = (argc > 1) ? atol(argv[1]) : 60;
+    if (seconds <= 0)
+        seconds = 1;
+    long frames = seconds * 30;
+
+    bool ok = true;
+    for (int partial = 0; partial < 2; ++partial)
+    {
+        Adafruit_SSD1306 display(SCREEN_WIDTH, SCREEN_HEIGHT, &Wire, -1);
+        display.begin(SSD1306_SWITCHCAPVCC, 0x3C);
+        randomSeed(99);
+        simMillis = 0;
+
+        AstroLib game(display);
+        game.attachTimeSource(simClock);
+        game.begin(25);
+        if (partial)
+            game.attachPartialFlush(Wire, 0x3C);
+        printf("--- %s flush ---\n", partial ? "partial" : "full");
+
+        ok = report("START", idle(game, display, frames), frames) && ok;
+
+        // Start a game and let the asteroids win
+        simMillis += 33;
+        game.update(JOYSTICK_CENTER, JOYSTICK_CENTER, true);
+        game.draw();
+        long played = 0;
+        while (game.getCurrentState() != GAME_OVER && played < 30L * 60 * 30)
+        {
+            simMillis += 33;
+            game.update(JOYSTICK_CENTER, JOYSTICK_CENTER, false);
+            game.draw();
+            played++;
+        }
+        if (game.getCurrentState() != GAME_OVER)
+        {
+            printf("game never ended\n");
+            ok = false;
+            continue;
+        }
+        ok = report("GAME_OVER", idle(game, display, frames), frames) && ok;
+    }
+    printf("%s\n", ok ? "ok" : "FAILED");
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,95 @@
+// bench_kernel.cpp - Batched circle-overlap kernel, SIMD vs scalar.
+// Tests every probe against every slot of a full pool through both kernels,
+// checks the hit masks are identical, and reports pairs tested per ns.
+//
+// Usage: bench_kernel [rounds]
+
+#include "CircleKernel.h"
+#include <chrono>
+#include <stdio.h>
+
+typedef std::chrono::steady_clock Clock;
+
+const int POOL_SLOTS = 1024;
+const int PROBES = 64;
+
+static uint32_t seed = 0xB17Eu;
+
+static int nextRandom(int range)
+{
+    seed = seed * 1664525u + 1013904223u;
+    return (int)((seed >> 8) % (uint32_t)range);
+}
+
+int main(int argc, char **argv)
+{
+    long rounds = (argc > 1) ? atol(argv[1]) : 2000;
+    if (rounds <= 0)
+        rounds = 1;
+
+    static EntityPool<POOL_SLOTS> pool;
+    static const int sizes[3] = {ASTEROID_SIZE_LARGE, ASTEROID_SIZE_MEDIUM, ASTEROID_SIZE_SMALL};
+    for (int n = 0; n < POOL_SLOTS; ++n)
+    {
+        int slot = pool.allocate();
+        pool.posX[slot] = nextRandom(SCREEN_WIDTH * 16) / 16.0f;
+        pool.posY[slot] = nextRandom(SCREEN_HEIGHT * 16) / 16.0f;
+        pool.radius[slot] = sizes[nextRandom(3)];
+    }
+    // Knock out some slots so the active mask matters
+    for (int n = 0; n < POOL_SLOTS / 8; ++n)
+        pool.release(nextRandom(POOL_SLOTS));
+
+    Scalar probeX[PROBES], probeY[PROBES];
+    for (int p = 0; p < PROBES; ++p)
+    {
+        probeX[p] = nextRandom(SCREEN_WIDTH * 16) / 16.0f;
+        probeY[p] = nextRandom(SCREEN_HEIGHT * 16) / 16.0f;
+    }
+    const Scalar probeRadius = BULLET_COLLISION_RADIUS;
+
+    // --- Correctness: identical masks ---
+    long mismatches = 0;
+    for (int p = 0; p < PROBES; ++p)
+    {
+        for (int w = 0; w < EntityPool<POOL_SLOTS>::WORDS; ++w)
+        {
+            uint32_t active = pool.activeWord(w);
+            mismatches += circleOverlapMask(pool, w, active, probeX[p], probeY[p], probeRadius) !=
+                          circleOverlapMaskScalar(pool, w, active, probeX[p], probeY[p], probeRadius);
+        }
+    }
+
+    // --- Throughput ---
+    uint32_t sink = 0;
+    Clock::time_point t0 = Clock::now();
+    for (long r = 0; r < rounds; ++r)
+    {
+        asm volatile("" ::: "memory");
+        for (int p = 0; p < PROBES; ++p)
+            for (int w = 0; w < EntityPool<POOL_SLOTS>::WORDS; ++w)
+                sink += circleOverlapMaskScalar(pool, w, pool.activeWord(w), probeX[p], probeY[p], probeRadius);
+    }
+    Clock::time_point t1 = Clock::now();
+    for (long r = 0; r < rounds; ++r)
+    {
+        asm volatile("" ::: "memory");
+        for (int p = 0; p < PROBES; ++p)
+            for (int w = 0; w < EntityPool<POOL_SLOTS>::WORDS; ++w)
+                sink -= circleOverlapMask(pool, w, pool.activeWord(w), probeX[p], probeY[p], probeRadius);
+    }
+    Clock::time_point t2 = Clock::now();
+
+    double pairs = (double)pool.count() * PROBES * rounds;
+    double scalarNs = std::chrono::duration<double, std::nano>(t1 - t0).count();
+    double batchNs = std::chrono::duration<double, std::nano>(t2 - t1).count();
+#if defined(ASTRO_SIMD_KERNEL)
+    const char *batchName = "simd";
+#else
+    const char *batchName = "scalar (no SIMD on this target)";
+#endif
+    printf("masks identical: %s\n", mismatches == 0 && sink == 0 ? "yes" : "NO");
+    printf("scalar kernel: %6.2f pairs/ns\n", pairs / scalarNs);
+    printf("%s kernel: %6.2f pairs/ns  (%.1fx)\n", batchName, pairs / batchNs, scalarNs / batchNs);
+    return (mismatches == 0 && sink == 0) ? 0 : 1;
+}
@@ -0,0 +1,218 @@
+// bench_leaderboard.cpp - Leaderboard persistence on the file-backed
+// Preferences stand-in.
+//   1. Plays hands-off games through AstroLib and counts flash writes:
+//      none may happen while a game is running, at most one per game
+//      after it, and a fresh instance must load the same table. Then
+//      again with the render task running, which does the writes itself.
+//   2. A burst of submissions must coalesce into a single write.
+//   3. Power fails at every byte of a commit: reloading must give either
+//      the table before the commit or the one after, never garbage.
+//   4. A unit with only the old single high-score key migrates it.
+//   5. A store that refuses every write is retried once per commit delay,
+//      not on every frame, and written once it works again.
+// Also reports the cost of submit() and commit().
+//
+// Usage: bench_leaderboard [games]
+
+#include <Adafruit_SSD1306.h>
+#include "AstroLib.h"
+#include <chrono>
+#include <stdio.h>
+#include <stdlib.h>
+#include <thread>
+
+typedef std::chrono::steady_clock Clock;
+
+static unsigned long simMillis = 0;
+static unsigned long simClock() { return simMillis; }
+
+static const char *STORE = "bench_leaderboard.nvs";
+
+static bool sameTable(const Leaderboard &a, const Leaderboard &b)
+{
+    if (a.count() != b.count())
+        return false;
+    for (int i = 0; i < a.count(); ++i)
+        if (a.score(i) != b.score(i))
+            return false;
+    return true;
+}
+
+static bool playGames(int games, bool pipelined)
+{
+    remove(STORE);
+    Preferences::hostUseFile(STORE);
+    Adafruit_SSD1306 display(SCREEN_WIDTH, SCREEN_HEIGHT, &Wire, -1);
+    display.begin(SSD1306_SWITCHCAPVCC, 0x3C);
+    randomSeed(5);
+    simMillis = 0;
+
+    AstroLib game(display);
+    game.attachTimeSource(simClock);
+    game.begin(25);
+    if (pipelined)
+        game.startRenderTask();
+
+    unsigned long writesInPlay = 0, writesBefore = Preferences::hostWriteCount();
+    uint32_t script = 77;
+    for (int g = 0; g < games; ++g)
+    {
+        // Fire to start, then wander and shoot until the asteroids win
+        for (int f = 0; game.getCurrentState() != GAME && f < 100; ++f)
+        {
+            simMillis += 33;
+            game.update(JOYSTICK_CENTER, JOYSTICK_CENTER, f & 1);
+        }
+        long frames = 0;
+        while (game.getCurrentState() != GAME_OVER && frames++ < 30L * 600)
+        {
+            script = script * 1664525u + 1013904223u;
+            unsigned long before = Preferences::hostWriteCount();
+            simMillis += 33;
+            game.update((int)((script >> 8) % 4096), JOYSTICK_CENTER, frames & 1);
+            if (!pipelined && (game.getCurrentState() == GAME || game.getCurrentState() == WAVE_CLEAR))
+                writesInPlay += Preferences::hostWriteCount() - before;
+        }
+        for (int f = 0; f < 150; ++f) // Five seconds on the game-over screen
+        {
+            simMillis += 33;
+            game.update(JOYSTICK_CENTER, JOYSTICK_CENTER, false);
+            if (pipelined)
+                std::this_thread::sleep_for(std::chrono::microseconds(500)); // Frame pacing: the render side gets time
+        }
+    }
+    game.stopRenderTask(); // Finishes a write still in flight
+    unsigned long writes = Preferences::hostWriteCount() - writesBefore;
+
+    Adafruit_SSD1306 display2(SCREEN_WIDTH, SCREEN_HEIGHT, &Wire, -1);
+    AstroLib reloaded(display2);
+    reloaded.begin(25);
+    bool same = reloaded.getLeaderboardCount() == game.getLeaderboardCount();
+    for (int i = 0; same && i < game.getLeaderboardCount(); ++i)
+        same = reloaded.getLeaderboardScore(i) == game.getLeaderboardScore(i);
+
+    if (pipelined)
+        printf("%d games, render task: %lu flash writes, table:", games, writes);
+    else
+        printf("%d games: %lu flash writes (%lu during play), table:", games, writes, writesInPlay);
+    for (int i = 0; i < game.getLeaderboardCount(); ++i)
+        printf(" %d", game.getLeaderboardScore(i));
+    printf(", reloads %s\n", same ? "identically" : "DIFFERENTLY");
+    Preferences::hostUseFile(NULL);
+    return writesInPlay == 0 && writes <= (unsigned long)games && same && game.getLeaderboardCount() > 0;
+}
+
+static bool coalesce()
+{
+    Preferences prefs;
+    prefs.begin("coalesce");
+    Leaderboard board;
+    board.begin(prefs);
+    unsigned long before = Preferences::hostWriteCount();
+    Clock::time_point t0 = Clock::now();
+    for (int i = 0; i < 1000; ++i)
+        board.submit(1000 + (i * 7919) % 5000, i); // One per ms
+    double submitNs = std::chrono::duration<double, std::nano>(Clock::now() - t0).count() / 1000;
+    for (unsigned long now = 1000; now < 1000 + 2 * LEADERBOARD_COMMIT_DELAY; now += 33)
+        board.commitIfDue(now);
+    unsigned long writes = Preferences::hostWriteCount() - before;
+
+    board.submit(9999, 0);
+    t0 = Clock::now();
+    board.commit(0);
+    double commitNs = std::chrono::duration<double, std::nano>(Clock::now() - t0).count();
+    printf("1000 submissions: %lu flash write(s); submit %.0f ns, commit %.0f ns (in-memory store)\n", writes,
+           submitNs, commitNs);
+    return writes == 1;
+}
+
+static bool powerLoss()
+{
+    long torn = 0, bad = 0;
+    for (size_t cut = 0; cut <= sizeof(LeaderboardRecord); ++cut)
+    {
+        for (int commitsBefore = 1; commitsBefore <= 2; ++commitsBefore) // Tear into slot B, then slot A
+        {
+            remove(STORE);
+            Preferences::hostUseFile(STORE);
+            Preferences prefs;
+            prefs.begin("AstroLib");
+            Leaderboard board;
+            board.begin(prefs);
+            for (int c = 0; c < commitsBefore; ++c)
+            {
+                board.submit(100 * (c + 1), 0);
+                board.commit(0);
+            }
+            Leaderboard before = board;
+            board.submit(5000, 0);
+            Leaderboard after = board;
+            Preferences::hostTearNextWrite(cut);
+            board.commit(0); // Power fails somewhere in here
+
+            Preferences rebooted;
+            rebooted.begin("AstroLib");
+            Leaderboard loaded;
+            loaded.begin(rebooted);
+            bool ok = sameTable(loaded, before) || sameTable(loaded, after);
+            torn++;
+            bad += !ok;
+        }
+    }
+    Preferences::hostUseFile(NULL);
+    remove(STORE);
+    printf("power loss at every byte of a commit: %ld cases, %ld corrupt loads\n", torn, bad);
+    return bad == 0;
+}
+
+static bool migrate()
+{
+    Preferences prefs;
+    prefs.begin("migrate");
+    prefs.putInt("highScore", 4321);
+    Leaderboard board;
+    board.begin(prefs, prefs.getInt("highScore", 0));
+    bool carried = board.best() == 4321 && board.isDirty();
+    board.commitIfDue(LEADERBOARD_COMMIT_DELAY);
+    Leaderboard reloaded;
+    reloaded.begin(prefs, 0);
+    bool ok = carried && reloaded.best() == 4321;
+    printf("legacy high score migrated: %s\n", ok ? "yes" : "NO");
+    return ok;
+}
+
+static bool failingStore()
+{
+    Preferences prefs;
+    prefs.begin("failing");
+    Leaderboard board;
+    board.begin(prefs);
+    board.submit(1234, 0);
+    const unsigned long span = 10 * LEADERBOARD_COMMIT_DELAY;
+    Preferences::hostFailWrites(true);
+    unsigned long before = Preferences::hostWriteCount();
+    for (unsigned long now = 0; now < span; now += 33) // Menu screen at 30 fps
+        board.commitIfDue(now);
+    unsigned long attempts = Preferences::hostWriteCount() - before;
+    Preferences::hostFailWrites(false);
+    bool recovered = board.commitIfDue(span + LEADERBOARD_COMMIT_DELAY) && !board.isDirty();
+    printf("store refusing writes for %lu ms: %lu attempt(s), written once it recovers: %s\n", span, attempts,
+           recovered ? "yes" : "NO");
+    return attempts <= span / LEADERBOARD_COMMIT_DELAY && recovered;
+}
+
+int main(int argc, char **argv)
+{
+    int games = (argc > 1) ? atoi(argv[1]) : 10;
+    if (games <= 0)
+        games = 1;
+    bool ok = playGames(games, false);
+    ok = playGames(games, true) && ok;
+    ok = coalesce() && ok;
+    ok = powerLoss() && ok;
+    ok = migrate() && ok;
+    ok = failingStore() && ok;
+    remove(STORE);
+    printf("%s\n", ok ? "ok" : "FAILED");
+    return ok ? 0 : 1;
+}
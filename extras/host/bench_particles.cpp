@@ -0,0 +1,105 @@
+// bench_particles.cpp - ParticlePool cost at full capacity.
+// Keeps the pool saturated with a chain of explosions far bigger than it
+// holds and reports the cost of one tick (update + drawing every live
+// particle into a framebuffer) under several budgets, and the cost of one
+// spawn. Also checks the budget is a hard cap on the window and that
+// particles wrap on screen.
+//
+// Usage: bench_particles [ticks]
+
+#include "FrameRaster.h"
+#include "ParticlePool.h"
+#include <chrono>
+#include <stdio.h>
+#include <stdlib.h>
+
+typedef std::chrono::steady_clock Clock;
+
+struct SpawnArgs {
+    uint16_t x, y;
+    int16_t vx, vy;
+    uint8_t life;
+};
+const int SPAWN_TABLE = 4096; // Precomputed, so the timing is the pool's
+
+static SpawnArgs spawnTable[SPAWN_TABLE];
+
+int main(int argc, char **argv)
+{
+    long ticks = (argc > 1) ? atol(argv[1]) : 200000;
+    if (ticks <= 0)
+        ticks = 1;
+
+    uint32_t lcg = 12345;
+    for (int i = 0; i < SPAWN_TABLE; ++i)
+    {
+        uint32_t r[5];
+        for (int k = 0; k < 5; ++k)
+        {
+            lcg = lcg * 1664525u + 1013904223u;
+            r[k] = lcg >> 8;
+        }
+        spawnTable[i].x = r[0] & 0x7FFF;
+        spawnTable[i].y = r[1] & 0x3FFF;
+        spawnTable[i].vx = (int16_t)(r[2] % 512) - 256;
+        spawnTable[i].vy = (int16_t)(r[3] % 512) - 256;
+        spawnTable[i].life = 5 + r[4] % 10;
+    }
+
+    static uint8_t framebuffer[SCREEN_WIDTH * SCREEN_HEIGHT / 8];
+    FrameRaster raster;
+    raster.setBuffer(framebuffer);
+
+    const int budgets[] = {16, 32, PARTICLE_BUDGET, PARTICLE_CAPACITY};
+    bool ok = true;
+    printf("capacity %d, %ld ticks, 40 debris spawned per tick\n", PARTICLE_CAPACITY, ticks);
+    for (size_t b = 0; b < sizeof(budgets) / sizeof(budgets[0]); ++b)
+    {
+        static ParticlePool<PARTICLE_CAPACITY> pool;
+        pool.clear();
+        pool.setBudget(budgets[b]);
+        int worstWindow = 0;
+        long drawn = 0;
+        uint32_t offscreen = 0;
+        uint32_t droppedBefore = pool.droppedCount();
+        Clock::duration spawnTime(0), tickTime(0);
+        int next = 0;
+
+        for (long t = 0; t < ticks; ++t)
+        {
+            Clock::time_point t0 = Clock::now();
+            for (int k = 0; k < 40; ++k) // Two large asteroids breaking up, every tick
+            {
+                const SpawnArgs &a = spawnTable[next++ & (SPAWN_TABLE - 1)];
+                pool.spawn(a.x, a.y, a.vx, a.vy, a.life);
+            }
+            Clock::time_point t1 = Clock::now();
+            pool.update();
+            for (uint32_t n = pool.windowStart(); n != pool.windowEnd(); ++n)
+            {
+                int i = pool.slot(n);
+                int x = pool.posX[i] >> 8, y = pool.posY[i] >> 8;
+                offscreen |= (uint32_t)(x >= SCREEN_WIDTH) | (uint32_t)(y >= SCREEN_HEIGHT);
+                if (pool.life[i])
+                {
+                    raster.pixel(x, y);
+                    drawn++;
+                }
+            }
+            tickTime += Clock::now() - t1;
+            spawnTime += t1 - t0;
+            worstWindow = max(worstWindow, pool.windowSize());
+        }
+        double tickNs = std::chrono::duration<double, std::nano>(tickTime).count() / ticks;
+        double spawnNs = std::chrono::duration<double, std::nano>(spawnTime).count() / (ticks * 40.0);
+
+        bool capped = worstWindow <= budgets[b];
+        ok = ok && capped && !offscreen;
+        printf("budget %3d: update + draw %6.1f ns/tick (%4.2f ns/particle), spawn %4.2f ns, "
+               "drawn %4.1f/tick, window max %2d, dropped %lu %s\n",
+               budgets[b], tickNs, tickNs / max(worstWindow, 1), spawnNs, (double)drawn / ticks, worstWindow,
+               (unsigned long)(pool.droppedCount() - droppedBefore), capped ? "" : "OVER BUDGET");
+    }
+    printf("%s\n", ok ? "ok" : "FAILED");
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,178 @@
+// bench_pipeline.cpp - Simulation/render pipeline on two host threads.
+// 1. Tear test: a writer thread publishes FrameSnapshots whose every field
+//    is derived from the sequence number while a reader thread acquires
+//    them; any snapshot mixing two publishes, or going backwards, fails.
+// 2. Runs AstroLib with startRenderTask() and compares the simulation
+//    thread's per-frame cost against update()+draw() on one thread. Once
+//    the render task runs, attachPartialFlush() must be refused.
+//
+// Usage: bench_pipeline [publishes] [frames]
+
+#include <Wire.h>
+#include <Adafruit_SSD1306.h>
+#include "AstroLib.h"
+#include <atomic>
+#include <chrono>
+#include <stdio.h>
+#include <thread>
+
+typedef std::chrono::steady_clock Clock;
+
+static void fillSnapshot(FrameSnapshot &snap, uint32_t seq)
+{
+    snap.sequence = seq;
+    snap.state = (GameState)(seq % 4);
+    snap.time = seq * 33ul;
+    snap.ship.pos.x = (int)(seq & 0xFFFF);
+    snap.ship.pos.y = (int)(seq >> 16);
+    snap.ship.lifetime = (int)seq;
+    snap.score = (int)seq;
+    snap.highScore = (int)~seq;
+    snap.lives = (int)(seq % 7);
+    snap.bulletCount = MAX_BULLETS;
+    for (int i = 0; i < MAX_BULLETS; ++i)
+    {
+        snap.bulletX[i] = (int16_t)(seq + i);
+        snap.bulletY[i] = (int16_t)(seq - i);
+    }
+    snap.asteroidCount = MAX_ASTEROIDS;
+    for (int i = 0; i < MAX_ASTEROIDS; ++i)
+    {
+        snap.asteroidX[i] = (int16_t)(seq * 3 + i);
+        snap.asteroidY[i] = (int16_t)(seq * 5 + i);
+        snap.asteroidSize[i] = (int8_t)(seq + i);
+        snap.asteroidMesh[i].vertexCount = (uint8_t)seq;
+        for (int v = 0; v < MAX_ASTEROID_VERTICES; ++v)
+        {
+            snap.asteroidMesh[i].dx[v] = (int8_t)(seq + v);
+            snap.asteroidMesh[i].dy[v] = (int8_t)(seq - v);
+        }
+    }
+}
+
+static bool snapshotIsWhole(const FrameSnapshot &snap)
+{
+    static FrameSnapshot expected; // Reader thread only
+    memset(&expected, 0, sizeof(expected));
+    fillSnapshot(expected, snap.sequence);
+    // Compare field by field: struct padding is not part of a publish
+    bool ok = snap.state == expected.state && snap.time == expected.time &&
+              snap.ship.pos.x == expected.ship.pos.x && snap.ship.pos.y == expected.ship.pos.y &&
+              snap.ship.lifetime == expected.ship.lifetime && snap.score == expected.score &&
+              snap.highScore == expected.highScore && snap.lives == expected.lives &&
+              snap.bulletCount == expected.bulletCount && snap.asteroidCount == expected.asteroidCount;
+    ok = ok && memcmp(snap.bulletX, expected.bulletX, sizeof(snap.bulletX)) == 0 &&
+         memcmp(snap.bulletY, expected.bulletY, sizeof(snap.bulletY)) == 0 &&
+         memcmp(snap.asteroidX, expected.asteroidX, sizeof(snap.asteroidX)) == 0 &&
+         memcmp(snap.asteroidY, expected.asteroidY, sizeof(snap.asteroidY)) == 0 &&
+         memcmp(snap.asteroidSize, expected.asteroidSize, sizeof(snap.asteroidSize)) == 0 &&
+         memcmp(snap.asteroidMesh, expected.asteroidMesh, sizeof(snap.asteroidMesh)) == 0;
+    return ok;
+}
+
+static bool tearTest(uint32_t publishes)
+{
+    static TripleBuffer<FrameSnapshot> buffer;
+    std::atomic<bool> done(false);
+    long acquired = 0, torn = 0, backwards = 0;
+
+    std::thread reader([&]() {
+        uint32_t last = 0;
+        for (;;)
+        {
+            bool finished = done.load(std::memory_order_acquire);
+            if (buffer.acquire())
+            {
+                const FrameSnapshot &snap = buffer.readSlot();
+                acquired++;
+                if (!snapshotIsWhole(snap))
+                    torn++;
+                if (snap.sequence <= last)
+                    backwards++;
+                last = snap.sequence;
+            }
+            else if (finished)
+                break;
+        }
+    });
+
+    for (uint32_t seq = 1; seq <= publishes; ++seq)
+    {
+        fillSnapshot(buffer.writeSlot(), seq);
+        buffer.publish();
+        if ((seq & 15) == 0)
+            std::this_thread::yield(); // Interleave even on a single-core machine
+    }
+    done.store(true, std::memory_order_release);
+    reader.join();
+
+    printf("tear test: %u published, %ld acquired, %ld torn, %ld out of order\n",
+           publishes, acquired, torn, backwards);
+    return torn == 0 && backwards == 0 && acquired > 0;
+}
+
+static unsigned long simMillis = 0; // Simulation thread only
+static unsigned long simClock() { return simMillis; }
+static bool flushRefused = true; // attachPartialFlush() with the render task running
+
+// Per-frame cost seen by the simulation loop, in ns
+static double runGame(long frames, bool pipelined, bool &panelOk)
+{
+    Adafruit_SSD1306 display(SCREEN_WIDTH, SCREEN_HEIGHT, &Wire, -1);
+    display.begin(SSD1306_SWITCHCAPVCC, 0x3C);
+    randomSeed(12345);
+    simMillis = 0;
+
+    AstroLib game(display);
+    game.attachTimeSource(simClock);
+    game.begin(25);
+    game.attachPartialFlush(Wire, 0x3C);
+    if (pipelined && !game.startRenderTask())
+        return 0;
+    if (pipelined)
+        flushRefused = !game.attachPartialFlush(Wire, 0x3C);
+
+    uint32_t script = 0x1234567u;
+    int joyX = JOYSTICK_CENTER, joyY = JOYSTICK_CENTER;
+    Clock::time_point t0 = Clock::now();
+    for (long f = 0; f < frames; ++f)
+    {
+        simMillis += 33;
+        if ((f & 15) == 0)
+        {
+            script = script * 1664525u + 1013904223u;
+            joyX = (int)((script >> 8) % 4096);
+            joyY = (int)((script >> 20) % 4096);
+        }
+        game.update(joyX, joyY, (f & 1) != 0);
+        game.draw(); // No-op while the render task runs
+    }
+    Clock::time_point t1 = Clock::now();
+
+    game.stopRenderTask();
+    game.draw(); // Settle on the final frame
+    panelOk = display.panelMatchesBuffer();
+    return std::chrono::duration<double, std::nano>(t1 - t0).count() / frames;
+}
+
+int main(int argc, char **argv)
+{
+    long publishes = (argc > 1) ? atol(argv[1]) : 2000000;
+    long frames = (argc > 2) ? atol(argv[2]) : 200000;
+    if (publishes <= 0)
+        publishes = 1;
+    if (frames <= 0)
+        frames = 1;
+
+    bool ok = tearTest((uint32_t)publishes);
+
+    bool serialPanel = false, pipelinedPanel = false;
+    double serialNs = runGame(frames, false, serialPanel);
+    double pipelinedNs = runGame(frames, true, pipelinedPanel);
+    printf("one thread:  %7.1f ns/frame (update + draw)\n", serialNs);
+    printf("pipelined:   %7.1f ns/frame (update; render on its own thread)\n", pipelinedNs);
+    printf("final panel matches framebuffer: %s\n", serialPanel && pipelinedPanel ? "yes" : "NO");
+    printf("partial flush attached while rendering: %s\n", flushRefused ? "refused" : "ACCEPTED");
+    ok = ok && serialPanel && pipelinedPanel && flushRefused;
+    return ok ? 0 : 1;
+}
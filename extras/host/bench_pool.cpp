@@ -0,0 +1,150 @@
+// bench_pool.cpp - EntityPool (SoA + active bitmask) vs the GameObject array
+// with a bool active flag that AstroLib used before.
+// Both sides run the same churn: move every live object, expire the ones
+// whose lifetime ran out, count the survivors and refill free slots. The
+// position checksums must agree; reported cost is ns per simulated frame.
+//
+// Usage: bench_pool [frames]
+
+#include "EntityPool.h"
+#include <chrono>
+#include <stdio.h>
+
+typedef std::chrono::steady_clock Clock;
+
+// The old layout, as the game used it
+template <int Capacity>
+struct ObjectArray {
+    GameObject objects[Capacity];
+
+    ObjectArray()
+    {
+        for (int i = 0; i < Capacity; ++i)
+            objects[i].active = false;
+    }
+
+    int allocate()
+    {
+        for (int i = 0; i < Capacity; ++i)
+        {
+            if (!objects[i].active)
+            {
+                objects[i].active = true;
+                return i;
+            }
+        }
+        return -1;
+    }
+
+    int count() const
+    {
+        int n = 0;
+        for (int i = 0; i < Capacity; ++i)
+            n += objects[i].active;
+        return n;
+    }
+};
+
+// Lifetime for the k-th spawn: short enough that the pool keeps churning
+static int16_t spawnLifetime(uint32_t k)
+{
+    return (int16_t)(8 + (k * 2654435761u >> 26)); // 8..71 frames
+}
+
+template <int Capacity>
+static double runArray(long frames, int target, double &checksum)
+{
+    static ObjectArray<Capacity> pool;
+    uint32_t spawned = 0;
+    checksum = 0;
+    Clock::time_point t0 = Clock::now();
+    for (long f = 0; f < frames; ++f)
+    {
+        for (int i = 0; i < Capacity; ++i)
+        {
+            GameObject &o = pool.objects[i];
+            if (!o.active)
+                continue;
+            o.pos.x += o.vel.x;
+            o.pos.y += o.vel.y;
+            if (--o.lifetime <= 0)
+            {
+                checksum += toFloat(o.pos.x) + toFloat(o.pos.y);
+                o.active = false;
+            }
+        }
+        for (int live = pool.count(); live < target; ++live)
+        {
+            int slot = pool.allocate();
+            GameObject &o = pool.objects[slot];
+            o.pos.x = (Scalar)(int)(spawned & 127);
+            o.pos.y = (Scalar)(int)((spawned >> 7) & 63);
+            o.vel.x = 0.5f;
+            o.vel.y = -0.25f;
+            o.radius = 1;
+            o.lifetime = spawnLifetime(spawned++);
+        }
+    }
+    Clock::time_point t1 = Clock::now();
+    return std::chrono::duration<double, std::nano>(t1 - t0).count() / frames;
+}
+
+template <int Capacity>
+static double runPool(long frames, int target, double &checksum)
+{
+    static EntityPool<Capacity> pool;
+    uint32_t spawned = 0;
+    checksum = 0;
+    Clock::time_point t0 = Clock::now();
+    for (long f = 0; f < frames; ++f)
+    {
+        for (int i = pool.first(); i >= 0; i = pool.next(i))
+        {
+            pool.posX[i] += pool.velX[i];
+            pool.posY[i] += pool.velY[i];
+            if (--pool.lifetime[i] <= 0)
+            {
+                checksum += toFloat(pool.posX[i]) + toFloat(pool.posY[i]);
+                pool.release(i);
+            }
+        }
+        for (int live = pool.count(); live < target; ++live)
+        {
+            int slot = pool.allocate();
+            pool.posX[slot] = (Scalar)(int)(spawned & 127);
+            pool.posY[slot] = (Scalar)(int)((spawned >> 7) & 63);
+            pool.velX[slot] = 0.5f;
+            pool.velY[slot] = -0.25f;
+            pool.radius[slot] = 1;
+            pool.lifetime[slot] = spawnLifetime(spawned++);
+        }
+    }
+    Clock::time_point t1 = Clock::now();
+    return std::chrono::duration<double, std::nano>(t1 - t0).count() / frames;
+}
+
+template <int Capacity>
+static bool compare(long frames)
+{
+    // Quarter full on average, like a wave part-way through
+    int target = Capacity / 4;
+    double arraySum, poolSum;
+    double arrayNs = runArray<Capacity>(frames, target, arraySum);
+    double poolNs = runPool<Capacity>(frames, target, poolSum);
+    bool same = arraySum == poolSum;
+    printf("capacity %4d  live %4d   array: %8.1f ns/frame   pool: %8.1f ns/frame  (%.1fx)%s\n",
+           Capacity, target, arrayNs, poolNs, arrayNs / poolNs, same ? "" : "  CHECKSUM MISMATCH");
+    return same;
+}
+
+int main(int argc, char **argv)
+{
+    long frames = (argc > 1) ? atol(argv[1]) : 200000;
+    if (frames <= 0)
+        frames = 1;
+
+    bool ok = compare<16>(frames);
+    ok &= compare<256>(frames);
+    ok &= compare<1024>(frames);
+    return ok ? 0 : 1;
+}
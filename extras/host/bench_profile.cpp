@@ -0,0 +1,132 @@
+// bench_profile.cpp - Per-phase frame profiler on the host.
+// Plays a scripted game at 30 Hz and reports the mean wall-clock cost of
+// update() + draw(). Built against astrolib_profiled it also dumps the
+// per-phase statistics, checks they are consistent and measures the cost
+// of one timed scope, and that a running render task hands its raster and
+// flush stats over; built against astrolib it checks the profiler is
+// really absent. Comparing the two frame costs gives the overhead.
+//
+// Usage: bench_profile [frames]
+
+#include <Adafruit_SSD1306.h>
+#include "AstroLib.h"
+#include <chrono>
+#include <stdio.h>
+#include <stdlib.h>
+#include <thread>
+
+typedef std::chrono::steady_clock Clock;
+
+static unsigned long simMillis = 0;
+static unsigned long simClock() { return simMillis; }
+
+class StdoutPrint : public Print {
+public:
+    size_t write(uint8_t c) override { return fputc(c, stdout) == EOF ? 0 : 1; }
+    using Print::write;
+};
+
+// Mean ns per frame of update() + draw()
+static double play(AstroLib &game, long frames)
+{
+    double totalNs = 0;
+    for (long f = 0; f < frames; ++f)
+    {
+        simMillis += 33;
+        uint32_t h = (uint32_t)(f / 20) * 2654435761u; // Stick moves every 20 frames
+        int joyX = (int)((h >> 4) % 4096);
+        int joyY = (int)((h >> 16) % 4096);
+        bool fire = (f % 6) < 2;
+
+        Clock::time_point t0 = Clock::now();
+        game.update(joyX, joyY, fire);
+        game.draw();
+        totalNs += std::chrono::duration<double, std::nano>(Clock::now() - t0).count();
+    }
+    return totalNs / frames;
+}
+
+int main(int argc, char **argv)
+{
+    long frames = (argc > 1) ? atol(argv[1]) : 3000;
+    if (frames < PROFILER_SAMPLES)
+        frames = PROFILER_SAMPLES;
+
+    Adafruit_SSD1306 display(SCREEN_WIDTH, SCREEN_HEIGHT, &Wire, -1);
+    display.begin(SSD1306_SWITCHCAPVCC, 0x3C);
+    randomSeed(7);
+
+    AstroLib game(display);
+    game.attachTimeSource(simClock);
+    game.begin(25);
+
+    play(game, frames / 4); // Warm up
+    game.resetProfile();
+    double bestNs = 1e18;
+    for (int run = 0; run < 3; ++run)
+        bestNs = fmin(bestNs, play(game, frames));
+    printf("%ld frames: %.0f ns per update() + draw() (best of 3)\n", frames, bestNs);
+
+    StdoutPrint out;
+    game.dumpProfile(out);
+
+    bool ok = true;
+    ProfileStats stats;
+#if defined(ASTRO_ENABLE_PROFILER)
+    for (int p = 0; p < PROFILE_PHASE_COUNT; ++p)
+    {
+        if (!game.getProfile((ProfilePhase)p, stats))
+        {
+            printf("no stats for %s\n", profilePhaseName((ProfilePhase)p));
+            ok = false;
+            continue;
+        }
+        long inHistogram = 0;
+        for (int b = 0; b < PROFILER_HISTOGRAM_BUCKETS; ++b)
+            inHistogram += stats.histogram[b];
+        bool consistent = stats.samples == PROFILER_SAMPLES && stats.minNs <= stats.meanNs &&
+                          stats.meanNs <= stats.maxNs && stats.minNs <= stats.p99Ns && stats.p99Ns <= stats.maxNs &&
+                          inHistogram == stats.samples;
+        if (!consistent)
+        {
+            printf("inconsistent stats for %s\n", profilePhaseName((ProfilePhase)p));
+            ok = false;
+        }
+    }
+
+    // Render task running: raster and flush stats come from its rings.
+    // Frames are paced so the render thread gets to run on one core too.
+    game.resetProfile();
+    if (game.startRenderTask())
+    {
+        for (int f = 0; f < 64; ++f)
+        {
+            play(game, 1);
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+        bool handedOver = game.getProfile(PROFILE_RASTER, stats) && stats.samples > 0;
+        game.stopRenderTask();
+        printf("render task stats handed over: %s\n", handedOver ? "yes" : "NO");
+        ok = ok && handedOver;
+    }
+
+    // Cost of one timed scope on its own
+    static FrameProfiler scratch;
+    const long scopes = 1000000;
+    Clock::time_point t0 = Clock::now();
+    for (long i = 0; i < scopes; ++i)
+    {
+        ASTRO_PROFILE(scratch, PROFILE_INPUT);
+    }
+    double scopeNs = std::chrono::duration<double, std::nano>(Clock::now() - t0).count() / scopes;
+    printf("one timed scope: %.1f ns\n", scopeNs);
+#else
+    if (game.getProfile(PROFILE_UPDATE, stats))
+    {
+        printf("profiler reported stats although compiled out\n");
+        ok = false;
+    }
+#endif
+    printf("%s\n", ok ? "ok" : "FAILED");
+    return ok ? 0 : 1;
+}
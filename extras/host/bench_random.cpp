@@ -0,0 +1,176 @@
+// bench_random.cpp - FastRandom speed against Arduino random(), plus
+// statistical sanity checks: reproducible seeding, chi-square uniformity of
+// bounded integers, no modulo bias on awkward ranges, per-bit balance and
+// the mean/variance/serial correlation of float output.
+//
+// Usage: bench_random [samples]
+
+#include <Arduino.h>
+#include "FastRandom.h"
+#include <chrono>
+#include <math.h>
+#include <stdio.h>
+#include <vector>
+
+typedef std::chrono::steady_clock Clock;
+
+static double nsPer(Clock::duration d, long n)
+{
+    return std::chrono::duration<double, std::nano>(d).count() / n;
+}
+
+static bool failed = false;
+
+static void check(bool ok, const char *what)
+{
+    printf("  %-52s %s\n", what, ok ? "ok" : "FAIL");
+    failed = failed || !ok;
+}
+
+// Chi-square of `counts` against a flat distribution, and whether it is
+// within 6 standard deviations of its expected value (df)
+static bool chiSquareFlat(const std::vector<long> &counts, long samples, double &chi2)
+{
+    double expected = (double)samples / counts.size();
+    chi2 = 0;
+    for (size_t i = 0; i < counts.size(); ++i)
+    {
+        double d = counts[i] - expected;
+        chi2 += d * d / expected;
+    }
+    double df = counts.size() - 1;
+    return chi2 < df + 6 * sqrt(2 * df);
+}
+
+int main(int argc, char **argv)
+{
+    long samples = (argc > 1) ? atol(argv[1]) : 10000000;
+    if (samples < 100000)
+        samples = 100000;
+
+    // --- Throughput ---
+    volatile long sink = 0;
+    randomSeed(1);
+    Clock::time_point t0 = Clock::now();
+    long acc = 0;
+    for (long i = 0; i < samples; ++i)
+        acc += random(0, 128);
+    Clock::time_point t1 = Clock::now();
+    sink = acc;
+
+    FastRandom rng(1);
+    acc = 0;
+    for (long i = 0; i < samples; ++i)
+        acc += rng.range(0, 128);
+    Clock::time_point t2 = Clock::now();
+    sink = acc;
+
+    float facc = 0;
+    for (long i = 0; i < samples; ++i)
+        facc += rng.uniform(0.7f, 1.3f);
+    Clock::time_point t3 = Clock::now();
+    sink = (long)facc;
+
+    float batch[16];
+    for (long i = 0; i < samples; i += 16)
+    {
+        rng.fillUniform(batch, 16, 0.7f, 1.3f);
+        facc += batch[i & 15];
+    }
+    Clock::time_point t4 = Clock::now();
+    sink = (long)facc;
+    (void)sink;
+
+    printf("Arduino random(0, 128):      %6.2f ns/value\n", nsPer(t1 - t0, samples));
+    printf("FastRandom::range(0, 128):   %6.2f ns/value\n", nsPer(t2 - t1, samples));
+    printf("FastRandom::uniform():       %6.2f ns/value\n", nsPer(t3 - t2, samples));
+    printf("FastRandom::fillUniform(16): %6.2f ns/value\n", nsPer(t4 - t3, samples));
+
+    // --- Statistics ---
+    printf("statistical checks (%ld samples each):\n", samples);
+
+    FastRandom a(42), b(42), c(43);
+    bool same = true, differ = false;
+    for (int i = 0; i < 100000; ++i)
+    {
+        uint32_t x = a.next();
+        same = same && x == b.next();
+        differ = differ || x != c.next();
+    }
+    check(same && differ, "equal seeds repeat, neighbouring seeds diverge");
+
+    const uint32_t ranges[] = {2, 6, 10, 37, 1000};
+    for (size_t r = 0; r < sizeof(ranges) / sizeof(ranges[0]); ++r)
+    {
+        std::vector<long> counts(ranges[r], 0);
+        for (long i = 0; i < samples; ++i)
+            counts[rng.below(ranges[r])]++;
+        double chi2;
+        bool ok = chiSquareFlat(counts, samples, chi2);
+        char label[64];
+        snprintf(label, sizeof(label), "below(%u) uniform (chi2 %.1f, df %u)", ranges[r], chi2, ranges[r] - 1);
+        check(ok, label);
+    }
+
+    // n = 3 * 2^30: plain modulo returns the lowest third twice as often
+    const uint32_t awkward = 3u << 30;
+    std::vector<long> lemire(3, 0), modulo(3, 0);
+    for (long i = 0; i < samples; ++i)
+    {
+        lemire[rng.below(awkward) >> 30]++;
+        modulo[(rng.next() % awkward) >> 30]++;
+    }
+    double chiLemire, chiModulo;
+    bool lemireOk = chiSquareFlat(lemire, samples, chiLemire);
+    bool moduloOk = chiSquareFlat(modulo, samples, chiModulo);
+    char label[96];
+    snprintf(label, sizeof(label), "below(3<<30) unbiased (chi2 %.1f; modulo %.0f)", chiLemire, chiModulo);
+    check(lemireOk && !moduloOk, label);
+
+    long bitCounts[32] = {};
+    for (long i = 0; i < samples; ++i)
+    {
+        uint32_t x = rng.next();
+        for (int bit = 0; bit < 32; ++bit)
+            bitCounts[bit] += (x >> bit) & 1;
+    }
+    double worstBitSigma = 0;
+    for (int bit = 0; bit < 32; ++bit)
+        worstBitSigma = fmax(worstBitSigma, fabs(bitCounts[bit] - samples / 2.0) / sqrt(samples / 4.0));
+    snprintf(label, sizeof(label), "every bit set half the time (worst %.2f sigma)", worstBitSigma);
+    check(worstBitSigma < 5, label);
+
+    double sum = 0, sumSq = 0, lagSum = 0;
+    float lo = 1, hi = 0, prev = rng.nextFloat();
+    for (long i = 0; i < samples; ++i)
+    {
+        float f = rng.nextFloat();
+        sum += f;
+        sumSq += (double)f * f;
+        lagSum += (double)(f - 0.5) * (prev - 0.5);
+        lo = fmin(lo, f);
+        hi = fmax(hi, f);
+        prev = f;
+    }
+    double mean = sum / samples;
+    double variance = sumSq / samples - mean * mean;
+    double correlation = lagSum / samples / (1.0 / 12);
+    double sigma = 1 / sqrt((double)samples);
+    snprintf(label, sizeof(label), "nextFloat() in [0, 1), mean %.4f, variance %.4f", mean, variance);
+    check(lo >= 0 && hi < 1 && fabs(mean - 0.5) < 6 * sigma * sqrt(1.0 / 12) && fabs(variance - 1.0 / 12) < 0.001,
+          label);
+    snprintf(label, sizeof(label), "lag-1 serial correlation %.5f", correlation);
+    check(fabs(correlation) < 6 * sigma, label);
+
+    bool rangeOk = true;
+    int seen = 0;
+    for (int i = 0; i < 10000; ++i)
+    {
+        long v = rng.range(-3, 4);
+        rangeOk = rangeOk && v >= -3 && v < 4;
+        seen |= 1 << (v + 3);
+    }
+    check(rangeOk && seen == 0x7F && rng.range(5, 5) == 5, "range() matches random(min, max) bounds");
+
+    return failed ? 1 : 0;
+}
@@ -0,0 +1,86 @@
+// bench_raster.cpp - FrameRaster vs the Adafruit_GFX drawLine/drawPixel path.
+// Draws the same random line set both ways, checks the framebuffers are
+// identical, and reports pixels per microsecond.
+//
+// Usage: bench_raster [rounds]
+
+#include <Adafruit_SSD1306.h>
+#include "FrameRaster.h"
+#include <chrono>
+#include <stdio.h>
+#include <vector>
+
+typedef std::chrono::steady_clock Clock;
+
+struct Segment {
+    int16_t x0, y0, x1, y1;
+};
+
+int main(int argc, char **argv)
+{
+    long rounds = (argc > 1) ? atol(argv[1]) : 2000;
+    if (rounds <= 0)
+        rounds = 1;
+
+    // Game-like mix: short outline edges, mostly on screen, some crossing edges
+    std::vector<Segment> segments;
+    uint32_t seed = 0xC0FFEEu;
+    long pixelsPerRound = 0;
+    for (int i = 0; i < 512; ++i)
+    {
+        seed = seed * 1664525u + 1013904223u;
+        Segment s;
+        s.x0 = (int16_t)((seed >> 8) % (SCREEN_WIDTH + 16)) - 8;
+        s.y0 = (int16_t)((seed >> 16) % (SCREEN_HEIGHT + 16)) - 8;
+        seed = seed * 1664525u + 1013904223u;
+        s.x1 = s.x0 + (int16_t)((seed >> 8) % 25) - 12;
+        s.y1 = s.y0 + (int16_t)((seed >> 16) % 25) - 12;
+        segments.push_back(s);
+        pixelsPerRound += max(abs(s.x1 - s.x0), abs(s.y1 - s.y0)) + 1;
+    }
+
+    Adafruit_SSD1306 gfx(SCREEN_WIDTH, SCREEN_HEIGHT, &Wire, -1);
+    Adafruit_SSD1306 direct(SCREEN_WIDTH, SCREEN_HEIGHT, &Wire, -1);
+    FrameRaster raster;
+    raster.setBuffer(direct.getBuffer());
+
+    // --- Correctness: identical pixels ---
+    for (size_t i = 0; i < segments.size(); ++i)
+    {
+        const Segment &s = segments[i];
+        gfx.drawLine(s.x0, s.y0, s.x1, s.y1, SSD1306_WHITE);
+        raster.line(s.x0, s.y0, s.x1, s.y1);
+    }
+    bool identical = memcmp(gfx.getBuffer(), direct.getBuffer(), SCREEN_WIDTH * SCREEN_HEIGHT / 8) == 0;
+
+    // --- Throughput ---
+    Clock::time_point t0 = Clock::now();
+    for (long r = 0; r < rounds; ++r)
+    {
+        gfx.clearDisplay();
+        for (size_t i = 0; i < segments.size(); ++i)
+        {
+            const Segment &s = segments[i];
+            gfx.drawLine(s.x0, s.y0, s.x1, s.y1, SSD1306_WHITE);
+        }
+    }
+    Clock::time_point t1 = Clock::now();
+    for (long r = 0; r < rounds; ++r)
+    {
+        direct.clearDisplay();
+        for (size_t i = 0; i < segments.size(); ++i)
+        {
+            const Segment &s = segments[i];
+            raster.line(s.x0, s.y0, s.x1, s.y1);
+        }
+    }
+    Clock::time_point t2 = Clock::now();
+
+    double gfxUs = std::chrono::duration<double, std::micro>(t1 - t0).count();
+    double rasterUs = std::chrono::duration<double, std::micro>(t2 - t1).count();
+    double pixels = (double)pixelsPerRound * rounds;
+    printf("pixels identical: %s\n", identical ? "yes" : "NO");
+    printf("gfx path:    %7.1f pixels/us\n", pixels / gfxUs);
+    printf("FrameRaster: %7.1f pixels/us  (%.1fx)\n", pixels / rasterUs, gfxUs / rasterUs);
+    return identical ? 0 : 1;
+}
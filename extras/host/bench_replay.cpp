@@ -0,0 +1,239 @@
+// bench_replay.cpp - Recorded sessions as repeatable workloads.
+// Records a corpus of scripted sessions (or loads .ail logs given on the
+// command line), then replays each one at full speed into a fresh AstroLib.
+// Every replay must end on the checksum stored at record time. Reports the
+// log size and the update/draw cost per frame in each game state.
+//
+// Usage: bench_replay [frames] [--save DIR] [session.ail ...]
+
+#include <Wire.h>
+#include <Adafruit_SSD1306.h>
+#include "AstroLib.h"
+#include <chrono>
+#include <stdio.h>
+#include <string>
+#include <vector>
+
+typedef std::chrono::steady_clock Clock;
+
+static unsigned long simMillis = 0;
+static unsigned long simClock() { return simMillis; }
+
+const int HYPERSPACE_PIN = 5;
+
+struct Session {
+    std::string name;
+    std::vector<uint8_t> log;
+    uint32_t frames;
+};
+
+enum Style { STEADY_30, STEADY_60, JITTER, HYPERSPACE, MOSTLY_IDLE };
+
+// One player's input for frame f. The stick holds still for a while then
+// moves, with the odd count of ADC noise, like a real thumbstick.
+static void scriptedFrame(Style style, uint32_t f, uint32_t &rng, unsigned long &dt, int &joyX, int &joyY,
+                          bool &fire, bool &hyperspace)
+{
+    rng = rng * 1664525u + 1013904223u;
+    static const int pattern30[] = {33, 33, 34};
+    static const int pattern60[] = {17, 17, 16};
+    switch (style)
+    {
+    case STEADY_60:
+        dt = pattern60[f % 3];
+        break;
+    case JITTER:
+        dt = 5 + (rng >> 16) % 56;
+        break;
+    default:
+        dt = pattern30[f % 3];
+        break;
+    }
+
+    uint32_t hold = (style == MOSTLY_IDLE) ? 300 : 24;
+    uint32_t h = (f / hold + 1) * 2654435761u;
+    h ^= h >> 15;
+    joyX = (int)(h % 4096);
+    joyY = (int)((h >> 12) % 4096);
+    if ((rng >> 28) == 0)
+        joyX += ((rng >> 8) & 1) ? 1 : -1; // ADC jitter on about 1 frame in 16
+    if (style == MOSTLY_IDLE && (f / hold) % 2)
+        joyX = joyY = JOYSTICK_CENTER;
+
+    fire = (style == MOSTLY_IDLE) ? (f % 200) < 2 : (f % 6) < 3;
+    hyperspace = (style == HYPERSPACE) && (f % 40) == 0;
+}
+
+static Session record(const char *name, Style style, uint32_t seed, uint32_t frames)
+{
+    Adafruit_SSD1306 display(SCREEN_WIDTH, SCREEN_HEIGHT, &Wire, -1);
+    display.begin(SSD1306_SWITCHCAPVCC, 0x3C);
+    simMillis = 0;
+
+    AstroLib game(display);
+    game.attachTimeSource(simClock);
+    game.attachHyperspaceButtonPin(HYPERSPACE_PIN);
+    game.begin(25);
+
+    std::vector<uint8_t> buffer(frames * 4 + 64); // Worst case: every field changes every frame
+    InputLogWriter writer(buffer.data(), buffer.size());
+    game.startRecording(writer, seed);
+
+    uint32_t rng = seed;
+    for (uint32_t f = 0; f < frames; ++f)
+    {
+        unsigned long dt;
+        int joyX, joyY;
+        bool fire, hyperspace;
+        scriptedFrame(style, f, rng, dt, joyX, joyY, fire, hyperspace);
+        simMillis += dt;
+        hostSetDigitalPin(HYPERSPACE_PIN, hyperspace ? LOW : HIGH);
+        game.update(joyX, joyY, fire);
+        game.draw();
+    }
+    game.stopRecording();
+    hostSetDigitalPin(HYPERSPACE_PIN, HIGH);
+
+    Session session = {name, std::vector<uint8_t>(buffer.begin(), buffer.begin() + writer.size()),
+                       writer.frameCount()};
+    if (writer.overflowed())
+        session.log.clear();
+    return session;
+}
+
+struct PhaseCost {
+    long frames;
+    double updateNs;
+    double drawNs;
+};
+
+static const char *phaseName(int state)
+{
+    static const char *names[] = {"START", "GAME", "GAME_OVER", "WAVE_CLEAR"};
+    return names[state];
+}
+
+// Replays one log; false if it is damaged or ends on a different checksum
+static bool replay(const Session &session, PhaseCost phases[4])
+{
+    Adafruit_SSD1306 display(SCREEN_WIDTH, SCREEN_HEIGHT, &Wire, -1);
+    display.begin(SSD1306_SWITCHCAPVCC, 0x3C);
+
+    AstroLib game(display); // Left on the real clock: a replay must not read it
+    game.begin(25);
+
+    InputLogReader reader(session.log.data(), session.log.size());
+    if (!game.startReplay(reader))
+    {
+        printf("%-12s not a session log\n", session.name.c_str());
+        return false;
+    }
+    long frames = 0;
+    for (;;)
+    {
+        int phase = game.getCurrentState();
+        Clock::time_point t0 = Clock::now();
+        if (!game.replayFrame())
+            break;
+        Clock::time_point t1 = Clock::now();
+        game.draw();
+        Clock::time_point t2 = Clock::now();
+        phases[phase].frames++;
+        phases[phase].updateNs += std::chrono::duration<double, std::nano>(t1 - t0).count();
+        phases[phase].drawNs += std::chrono::duration<double, std::nano>(t2 - t1).count();
+        frames++;
+    }
+
+    uint32_t checksum = game.stateChecksum();
+    bool ok = reader.hasChecksum() && reader.checksum() == checksum;
+    printf("%-12s %7ld frames %7zu bytes (%.2f B/frame)  score %5d  checksum %08x %s\n",
+           session.name.c_str(), frames, session.log.size(), (double)session.log.size() / max(frames, 1L),
+           game.getScore(), checksum, ok ? "ok" : "MISMATCH");
+    return ok;
+}
+
+static bool loadFile(const char *path, Session &session)
+{
+    FILE *f = fopen(path, "rb");
+    if (!f)
+        return false;
+    uint8_t chunk[4096];
+    size_t n;
+    while ((n = fread(chunk, 1, sizeof(chunk), f)) > 0)
+        session.log.insert(session.log.end(), chunk, chunk + n);
+    fclose(f);
+    session.name = path;
+    session.frames = 0;
+    return true;
+}
+
+static bool saveFile(const std::string &path, const Session &session)
+{
+    FILE *f = fopen(path.c_str(), "wb");
+    if (!f)
+        return false;
+    bool ok = fwrite(session.log.data(), 1, session.log.size(), f) == session.log.size();
+    return fclose(f) == 0 && ok;
+}
+
+int main(int argc, char **argv)
+{
+    long frames = 30000;
+    const char *saveDir = NULL;
+    std::vector<Session> corpus;
+    for (int i = 1; i < argc; ++i)
+    {
+        std::string arg = argv[i];
+        if (arg == "--save" && i + 1 < argc)
+            saveDir = argv[++i];
+        else if (arg.find_first_not_of("0123456789") == std::string::npos)
+            frames = max(1L, atol(argv[i]));
+        else
+        {
+            Session session;
+            if (!loadFile(argv[i], session))
+            {
+                printf("cannot read %s\n", argv[i]);
+                return 1;
+            }
+            corpus.push_back(session);
+        }
+    }
+
+    if (corpus.empty())
+    {
+        corpus.push_back(record("steady30", STEADY_30, 2024, frames));
+        corpus.push_back(record("steady60", STEADY_60, 77, frames * 2));
+        corpus.push_back(record("jitter", JITTER, 31337, frames));
+        corpus.push_back(record("hyperspace", HYPERSPACE, 5, frames));
+        corpus.push_back(record("idle", MOSTLY_IDLE, 9, frames));
+        for (size_t i = 0; i < corpus.size(); ++i)
+        {
+            if (corpus[i].log.empty())
+            {
+                printf("%s: recording buffer overflowed\n", corpus[i].name.c_str());
+                return 1;
+            }
+            if (saveDir && !saveFile(std::string(saveDir) + "/" + corpus[i].name + ".ail", corpus[i]))
+            {
+                printf("cannot write %s/%s.ail\n", saveDir, corpus[i].name.c_str());
+                return 1;
+            }
+        }
+    }
+
+    PhaseCost phases[4] = {};
+    bool ok = true;
+    for (size_t i = 0; i < corpus.size(); ++i)
+        ok = replay(corpus[i], phases) && ok;
+
+    printf("\nphase        frames   update ns   draw ns\n");
+    for (int p = 0; p < 4; ++p)
+    {
+        if (phases[p].frames == 0)
+            continue;
+        printf("%-10s %8ld %11.1f %9.1f\n", phaseName(p), phases[p].frames,
+               phases[p].updateNs / phases[p].frames, phases[p].drawNs / phases[p].frames);
+    }
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,164 @@
+// bench_savestate.cpp - Save-state cost, delta size and rollback determinism.
+// Plays a scripted game, taking a save state every frame and encoding it
+// against the previous one. Every delta must decode forwards and backwards
+// to the exact bytes. Every ROLLBACK_EVERY frames it also plays
+// ROLLBACK_FRAMES ahead, loads the state from before them and plays the same
+// inputs again: both runs must end on the same checksum and the same state.
+// Torn, foreign and out-of-range states must be refused. Reports the state
+// size and the save, load, encode and decode cost.
+//
+// Usage: bench_savestate [frames]
+
+#include <Wire.h>
+#include <Adafruit_SSD1306.h>
+#include "AstroLib.h"
+#include <chrono>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <vector>
+
+typedef std::chrono::steady_clock Clock;
+
+static unsigned long simMillis = 0;
+static unsigned long simClock() { return simMillis; }
+
+const int HYPERSPACE_PIN = 5;
+const uint32_t ROLLBACK_EVERY = 90;
+const uint32_t ROLLBACK_FRAMES = 30;
+
+static double nanosSince(Clock::time_point t0)
+{
+    return std::chrono::duration<double, std::nano>(Clock::now() - t0).count();
+}
+
+// Steady 30 fps; the stick wanders, fire is mashed, the odd hyperspace jump
+static void playFrame(AstroLib &game, uint32_t f)
+{
+    static const int pattern30[] = {33, 33, 34};
+    uint32_t h = (f / 24 + 1) * 2654435761u;
+    h ^= h >> 15;
+    simMillis += pattern30[f % 3];
+    hostSetDigitalPin(HYPERSPACE_PIN, (f % 97) == 0 ? LOW : HIGH);
+    game.update((int)(h % 4096), (int)((h >> 12) % 4096), (f % 6) < 3);
+}
+
+int main(int argc, char **argv)
+{
+    uint32_t frames = (argc > 1) ? (uint32_t)max(1, atoi(argv[1])) : 5000;
+
+    Adafruit_SSD1306 display(SCREEN_WIDTH, SCREEN_HEIGHT, &Wire, -1);
+    display.begin(SSD1306_SWITCHCAPVCC, 0x3C);
+    AstroLib game(display);
+    game.attachTimeSource(simClock);
+    game.attachHyperspaceButtonPin(HYPERSPACE_PIN);
+    game.begin(25);
+    game.seedRandom(12345);
+
+    const size_t stateSize = sizeof(AstroLib::SaveState);
+    AstroLib::SaveState states[2], checkpoint, ahead, replayed;
+    std::vector<uint8_t> delta(maxStateDeltaSize(stateSize));
+    std::vector<uint8_t> decoded(stateSize);
+
+    double saveNs = 0, loadNs = 0, encodeNs = 0, decodeNs = 0;
+    long saves = 0, loads = 0, deltaBytes = 0, deltaMax = 0;
+    long deltaErrors = 0, rollbacks = 0, rollbackErrors = 0;
+    uint32_t f = 0;
+    int newest = 0;
+    game.saveState(states[newest]);
+    while (f < frames)
+    {
+        if (f % ROLLBACK_EVERY == ROLLBACK_EVERY - 1)
+        {
+            game.saveState(checkpoint);
+            unsigned long checkpointTime = simMillis;
+            for (uint32_t k = 0; k < ROLLBACK_FRAMES; ++k)
+                playFrame(game, f + k);
+            uint32_t expected = game.stateChecksum();
+            game.saveState(ahead);
+
+            simMillis = checkpointTime;
+            Clock::time_point t0 = Clock::now();
+            bool loaded = game.loadState(checkpoint);
+            loadNs += nanosSince(t0);
+            loads++;
+            for (uint32_t k = 0; k < ROLLBACK_FRAMES; ++k)
+                playFrame(game, f + k);
+            game.saveState(replayed);
+            rollbacks++;
+            if (!loaded || game.stateChecksum() != expected || memcmp(&ahead, &replayed, stateSize) != 0)
+            {
+                if (rollbackErrors++ == 0)
+                    printf("rollback at frame %u diverged (loaded %d)\n", f, loaded);
+            }
+            f += ROLLBACK_FRAMES;
+        }
+        else
+            playFrame(game, f++);
+        game.draw();
+
+        AstroLib::SaveState &previous = states[newest];
+        newest ^= 1;
+        AstroLib::SaveState &current = states[newest];
+        Clock::time_point t0 = Clock::now();
+        game.saveState(current);
+        saveNs += nanosSince(t0);
+        saves++;
+
+        t0 = Clock::now();
+        size_t bytes = encodeStateDelta(&previous, &current, stateSize, delta.data(), delta.size());
+        encodeNs += nanosSince(t0);
+        t0 = Clock::now();
+        bool forward = applyStateDelta(&previous, delta.data(), bytes, decoded.data(), stateSize) &&
+                       memcmp(decoded.data(), &current, stateSize) == 0;
+        decodeNs += nanosSince(t0);
+        bool backward = applyStateDelta(&current, delta.data(), bytes, decoded.data(), stateSize) &&
+                        memcmp(decoded.data(), &previous, stateSize) == 0;
+        if (!bytes || !forward || !backward)
+            deltaErrors++;
+        deltaBytes += (long)bytes;
+        deltaMax = max(deltaMax, (long)bytes);
+    }
+
+    // A torn, foreign or out-of-range state is refused and leaves the game
+    // alone. Each one but the torn copy is resealed, so the CRC passes.
+    const AstroLib::SaveState &last = states[newest];
+    int rock = max(0, last.asteroids.first());
+    AstroLib::SaveState bad[5] = {last, last, last, last, last};
+    ((uint8_t *)&bad[0])[stateSize / 2] ^= 0x10; // Torn write
+    bad[1].layout ^= 1;                         // Another build
+    bad[2].state = WAVE_CLEAR + 1;
+    bad[3].asteroidMeshes[rock].vertexCount = MAX_ASTEROID_VERTICES + 1;
+    bad[4].asteroids.posX[rock] = -1;
+    for (int b = 1; b < 5; ++b)
+        bad[b].seal();
+    uint32_t before = game.stateChecksum();
+    int refusedCount = 0;
+    for (int b = 0; b < 5; ++b)
+        refusedCount += !game.loadState(bad[b]);
+    bool refused = refusedCount == 5 && game.stateChecksum() == before;
+
+    // A load keeps the better of the live and saved high score
+    int best = game.getHighScore();
+    AstroLib::SaveState stale = last;
+    stale.highScore = best - 1;
+    stale.seal();
+    bool bestKept = game.loadState(stale) && game.getHighScore() == best;
+    stale.highScore = best + 1;
+    stale.seal();
+    bestKept = bestKept && game.loadState(stale) && game.getHighScore() == best + 1;
+
+    printf("save state %u bytes, %ld saves, %ld rollbacks of %u frames\n", (unsigned)stateSize, saves, rollbacks,
+           ROLLBACK_FRAMES);
+    printf("save    %8.0f ns\n", saveNs / saves);
+    printf("load    %8.0f ns\n", loadNs / max(1L, loads));
+    printf("encode  %8.0f ns  delta mean %.1f bytes (%.1f%% of a state), max %ld\n", encodeNs / saves,
+           (double)deltaBytes / saves, 100.0 * deltaBytes / saves / stateSize, deltaMax);
+    printf("decode  %8.0f ns\n", decodeNs / saves);
+    printf("delta round trips failed %ld, rollbacks diverged %ld, bad states refused %d/5, high score %s\n",
+           deltaErrors, rollbackErrors, refusedCount, bestKept ? "kept" : "LOWERED");
+
+    bool ok = deltaErrors == 0 && rollbackErrors == 0 && rollbacks > 0 && refused && bestKept;
+    printf("%s\n", ok ? "ok" : "FAILED");
+    return ok ? 0 : 1;
+}
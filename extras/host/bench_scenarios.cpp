@@ -0,0 +1,286 @@
+// bench_scenarios.cpp - Stress-world benchmark with regression thresholds.
+// Builds canned worlds straight into AstroLib's state and times update()
+// and draw() over thousands of frames in each:
+//   max_asteroids   every asteroid slot filled, spread over the screen
+//   bullets         full asteroid field with every bullet slot in flight
+//   dense_cluster   all asteroids piled in one spot with bullets aimed at it
+//   thrust          the ship thrusting and turning through a full field
+// Before every frame the world is topped back up (untimed), so it stays at
+// full load however much the frame destroyed. Results go to stdout as CSV.
+// With --baseline, any scenario whose update or draw cost exceeds the
+// stored value by more than the tolerance fails the run.
+//
+// Usage: bench_scenarios [frames] [--baseline FILE] [--tolerance PCT]
+//                        [--write-baseline FILE]
+
+#include <Adafruit_SSD1306.h>
+#include "AstroLib.h"
+#include <algorithm>
+#include <chrono>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <string>
+#include <vector>
+
+typedef std::chrono::steady_clock Clock;
+
+static unsigned long simMillis = 0;
+static unsigned long simClock() { return simMillis; }
+
+enum WorldKind { WORLD_MAX_ASTEROIDS, WORLD_BULLETS, WORLD_DENSE_CLUSTER, WORLD_THRUST, WORLD_COUNT };
+
+static const char *WORLD_NAMES[WORLD_COUNT] = {"max_asteroids", "bullets", "dense_cluster", "thrust"};
+
+const Scalar CLUSTER_X = SCREEN_WIDTH * 3 / 4;
+const Scalar CLUSTER_Y = SCREEN_HEIGHT / 2;
+const int CLUSTER_SPREAD = 6; // Pixels either side of the cluster centre
+
+// Reaches into AstroLib (a friend in host builds) to lay out worlds
+class ScenarioBuilder {
+public:
+    static void start(AstroLib &game)
+    {
+        game.resetGame();
+        game.currentState = GAME;
+        game.asteroids.clear();
+        game.bullets.clear();
+    }
+
+    // Refills the world to full load. Called before every timed frame.
+    static void topUp(AstroLib &game, WorldKind world)
+    {
+        static const int sizes[3] = {ASTEROID_SIZE_LARGE, ASTEROID_SIZE_MEDIUM, ASTEROID_SIZE_SMALL};
+        int n = 0;
+        while (game.asteroids.count() < MAX_ASTEROIDS)
+        {
+            Scalar x, y;
+            if (world == WORLD_DENSE_CLUSTER)
+            {
+                x = CLUSTER_X + game.rng.range(-CLUSTER_SPREAD, CLUSTER_SPREAD + 1);
+                y = CLUSTER_Y + game.rng.range(-CLUSTER_SPREAD, CLUSTER_SPREAD + 1);
+            }
+            else
+            {
+                x = game.rng.range(0, SCREEN_WIDTH);
+                y = game.rng.range(0, SCREEN_HEIGHT);
+            }
+            game.spawnAsteroid(world == WORLD_DENSE_CLUSTER ? sizes[n++ % 3] : ASTEROID_SIZE_LARGE, x, y);
+        }
+
+        if (world == WORLD_BULLETS || world == WORLD_DENSE_CLUSTER)
+        {
+            int slot;
+            while ((slot = game.bullets.allocate()) >= 0)
+            {
+                Scalar vx, vy;
+                if (world == WORLD_DENSE_CLUSTER)
+                { // Straight at the pile
+                    BAngle angle = fastAtan2(CLUSTER_Y - game.ship.pos.y, CLUSTER_X - game.ship.pos.x);
+                    sinCos(angle, vy, vx);
+                }
+                else
+                    sinCos((BAngle)(slot * 65536 / MAX_BULLETS), vy, vx); // Evenly fanned out
+                game.bullets.posX[slot] = game.ship.pos.x;
+                game.bullets.posY[slot] = game.ship.pos.y;
+                game.bullets.velX[slot] = vx * BULLET_SPEED;
+                game.bullets.velY[slot] = vy * BULLET_SPEED;
+                game.bullets.prevX[slot] = game.bullets.posX[slot];
+                game.bullets.prevY[slot] = game.bullets.posY[slot];
+                game.bullets.radius[slot] = BULLET_COLLISION_RADIUS;
+                game.bullets.lifetime[slot] = game.bulletLifetimeTicks;
+                game.bullets.size[slot] = 0;
+            }
+        }
+
+        // Never run out of lives or clear the wave
+        game.lives = 3;
+        game.currentState = GAME;
+    }
+};
+
+struct Result {
+    std::string name;
+    long frames;
+    double updateNs; // Mean per frame
+    double drawNs;
+    double p99FrameNs;
+};
+
+static void scriptedInput(WorldKind world, long f, int &joyX, int &joyY, bool &fire)
+{
+    joyX = JOYSTICK_CENTER;
+    joyY = JOYSTICK_CENTER;
+    fire = false;
+    if (world == WORLD_THRUST)
+    {
+        joyY = 0;                                                            // Full thrust
+        joyX = (f / 45) % 2 ? JOYSTICK_CENTER + 900 : JOYSTICK_CENTER - 600; // Weave
+    }
+    else if (world == WORLD_BULLETS)
+        fire = f & 1; // Fired shots join the ones placed in flight
+}
+
+static Result runWorld(WorldKind world, long frames)
+{
+    Adafruit_SSD1306 display(SCREEN_WIDTH, SCREEN_HEIGHT, &Wire, -1);
+    display.begin(SSD1306_SWITCHCAPVCC, 0x3C);
+    randomSeed(31337);
+    simMillis = 0;
+
+    AstroLib game(display);
+    game.attachTimeSource(simClock);
+    game.begin(25);
+    game.attachPartialFlush(Wire, 0x3C);
+    game.seedRandom(4242 + world);
+    ScenarioBuilder::start(game);
+
+    std::vector<double> frameNs(frames);
+    double updateNs = 0, drawNs = 0;
+    for (long f = 0; f < frames; ++f)
+    {
+        ScenarioBuilder::topUp(game, world);
+        int joyX, joyY;
+        bool fire;
+        scriptedInput(world, f, joyX, joyY, fire);
+        simMillis += 33;
+
+        Clock::time_point t0 = Clock::now();
+        game.update(joyX, joyY, fire);
+        Clock::time_point t1 = Clock::now();
+        game.draw();
+        Clock::time_point t2 = Clock::now();
+        double u = std::chrono::duration<double, std::nano>(t1 - t0).count();
+        double d = std::chrono::duration<double, std::nano>(t2 - t1).count();
+        updateNs += u;
+        drawNs += d;
+        frameNs[f] = u + d;
+    }
+    std::sort(frameNs.begin(), frameNs.end());
+
+    Result r;
+    r.name = WORLD_NAMES[world];
+    r.frames = frames;
+    r.updateNs = updateNs / frames;
+    r.drawNs = drawNs / frames;
+    r.p99FrameNs = frameNs[(frames * 99 + 99) / 100 - 1];
+    return r;
+}
+
+static void writeCsv(FILE *f, const std::vector<Result> &results)
+{
+    fprintf(f, "scenario,frames,update_ns,draw_ns,p99_frame_ns\n");
+    for (size_t i = 0; i < results.size(); ++i)
+        fprintf(f, "%s,%ld,%.0f,%.0f,%.0f\n", results[i].name.c_str(), results[i].frames, results[i].updateNs,
+                results[i].drawNs, results[i].p99FrameNs);
+}
+
+static bool readCsv(const char *path, std::vector<Result> &results)
+{
+    FILE *f = fopen(path, "r");
+    if (!f)
+        return false;
+    char line[256];
+    while (fgets(line, sizeof(line), f))
+    {
+        char name[64];
+        Result r;
+        if (sscanf(line, "%63[^,],%ld,%lf,%lf,%lf", name, &r.frames, &r.updateNs, &r.drawNs, &r.p99FrameNs) != 5)
+            continue; // Header or blank
+        r.name = name;
+        results.push_back(r);
+    }
+    fclose(f);
+    return true;
+}
+
+// Reports each scenario against its baseline; false if any got slower than allowed
+static bool compare(const std::vector<Result> &results, const std::vector<Result> &baseline, double tolerance)
+{
+    bool ok = true;
+    for (size_t b = 0; b < baseline.size(); ++b)
+    {
+        const Result *r = NULL;
+        for (size_t i = 0; i < results.size(); ++i)
+            if (results[i].name == baseline[b].name)
+                r = &results[i];
+        if (!r)
+        {
+            fprintf(stderr, "%-14s missing from this run\n", baseline[b].name.c_str());
+            ok = false;
+            continue;
+        }
+        double updateRatio = r->updateNs / baseline[b].updateNs;
+        double drawRatio = r->drawNs / baseline[b].drawNs;
+        bool pass = updateRatio <= 1 + tolerance && drawRatio <= 1 + tolerance;
+        fprintf(stderr, "%-14s update %+6.1f%%  draw %+6.1f%%  %s\n", r->name.c_str(), (updateRatio - 1) * 100,
+                (drawRatio - 1) * 100, pass ? "ok" : "REGRESSED");
+        ok = ok && pass;
+    }
+    return ok;
+}
+
+int main(int argc, char **argv)
+{
+    long frames = 20000;
+    const char *baselinePath = NULL;
+    const char *writePath = NULL;
+    double tolerance = 0.25;
+    for (int i = 1; i < argc; ++i)
+    {
+        if (strcmp(argv[i], "--baseline") == 0 && i + 1 < argc)
+            baselinePath = argv[++i];
+        else if (strcmp(argv[i], "--write-baseline") == 0 && i + 1 < argc)
+            writePath = argv[++i];
+        else if (strcmp(argv[i], "--tolerance") == 0 && i + 1 < argc)
+            tolerance = atof(argv[++i]) / 100;
+        else
+            frames = atol(argv[i]);
+    }
+    if (frames < 100)
+        frames = 100;
+
+    // Best of three runs per world, after a warm-up: the least disturbed by the machine
+    runWorld(WORLD_MAX_ASTEROIDS, frames / 4);
+    std::vector<Result> results;
+    for (int w = 0; w < WORLD_COUNT; ++w)
+    {
+        Result best = runWorld((WorldKind)w, frames);
+        for (int run = 1; run < 3; ++run)
+        {
+            Result r = runWorld((WorldKind)w, frames);
+            best.updateNs = fmin(best.updateNs, r.updateNs);
+            best.drawNs = fmin(best.drawNs, r.drawNs);
+            best.p99FrameNs = fmin(best.p99FrameNs, r.p99FrameNs);
+        }
+        results.push_back(best);
+    }
+    writeCsv(stdout, results);
+
+    if (writePath)
+    {
+        FILE *f = fopen(writePath, "w");
+        if (!f)
+        {
+            fprintf(stderr, "cannot write %s\n", writePath);
+            return 1;
+        }
+        writeCsv(f, results);
+        fclose(f);
+        fprintf(stderr, "baseline written to %s\n", writePath);
+    }
+
+    if (baselinePath)
+    {
+        std::vector<Result> baseline;
+        if (!readCsv(baselinePath, baseline) || baseline.empty())
+        {
+            fprintf(stderr, "cannot read baseline %s\n", baselinePath);
+            return 1;
+        }
+        fprintf(stderr, "against %s (tolerance %.0f%%):\n", baselinePath, tolerance * 100);
+        if (!compare(results, baseline, tolerance))
+            return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,169 @@
+// bench_synth.cpp - PCM synthesizer backend on the host.
+// Drives AudioEngine with a scripted mix of thrust, shots, explosions and
+// hyperspace on a simulated clock, streams every rendered block into a
+// 16 kHz mono WAV file and reports the synthesis cost per block as a share
+// of one core at real time. Also checks rendering never allocates, that
+// silence renders as silence and that sounds actually reach the output.
+//
+// Usage: bench_synth [seconds] [out.wav]
+
+#include <Arduino.h>
+#include "AudioEngine.h"
+#include "PcmSynth.h"
+#include <chrono>
+#include <new>
+#include <stdio.h>
+#include <stdlib.h>
+
+typedef std::chrono::steady_clock Clock;
+
+// --- Allocation counter ---
+static long allocations = 0;
+
+void *operator new(size_t size)
+{
+    allocations++;
+    void *p = malloc(size ? size : 1);
+    if (!p)
+        throw std::bad_alloc();
+    return p;
+}
+void operator delete(void *p) noexcept { free(p); }
+void operator delete(void *p, size_t) noexcept { free(p); }
+
+static unsigned long simMillis = 0;
+static unsigned long simClock() { return simMillis; }
+
+// --- WAV output ---
+static void putLE(FILE *f, uint32_t value, int bytes)
+{
+    for (int i = 0; i < bytes; ++i)
+        fputc((value >> (8 * i)) & 0xFF, f);
+}
+
+static void writeWavHeader(FILE *f, uint32_t samples)
+{
+    uint32_t dataBytes = samples * 2;
+    fwrite("RIFF", 1, 4, f);
+    putLE(f, 36 + dataBytes, 4);
+    fwrite("WAVEfmt ", 1, 8, f);
+    putLE(f, 16, 4);                     // fmt chunk size
+    putLE(f, 1, 2);                      // PCM
+    putLE(f, 1, 2);                      // Mono
+    putLE(f, SYNTH_SAMPLE_RATE, 4);
+    putLE(f, SYNTH_SAMPLE_RATE * 2, 4);  // Byte rate
+    putLE(f, 2, 2);                      // Block align
+    putLE(f, 16, 2);                     // Bits per sample
+    fwrite("data", 1, 4, f);
+    putLE(f, dataBytes, 4);
+}
+
+// What a game might ask for at time t (ms)
+static void script(AudioEngine &audio, unsigned long t)
+{
+    unsigned long phase = t % 10000;
+    if (phase == 500)
+        audio.startThrustSound(0.3f);
+    if (phase == 2500)
+        audio.stopThrustSound();
+    if (phase >= 4000 && phase < 9000 && phase % 180 == 0)
+        audio.playShootSound();
+    if (phase >= 4000 && phase % 700 == 350)
+        audio.playExplosionSound();
+    if (phase == 3000 || phase == 8000)
+        audio.playHyperspaceSound();
+    if (phase == 9500)
+        audio.stopAllSounds();
+}
+
+int main(int argc, char **argv)
+{
+    long seconds = (argc > 1) ? atol(argv[1]) : 20;
+    const char *path = (argc > 2) ? argv[2] : "bench_synth.wav";
+    if (seconds <= 0)
+        seconds = 1;
+
+    static PcmSynth synth; // Static: the ring is 2 KB
+    AudioEngine audio;
+    audio.attachTimeSource(simClock);
+    audio.attachSynth(synth);
+    audio.begin(25);
+
+    FILE *wav = fopen(path, "wb");
+    if (!wav)
+    {
+        printf("cannot write %s\n", path);
+        return 1;
+    }
+    writeWavHeader(wav, 0); // Sizes patched at the end
+
+    const long blockMs = SYNTH_BLOCK_SAMPLES * 1000 / SYNTH_SAMPLE_RATE;
+    long blocks = 0, clipped = 0;
+    uint32_t samples = 0;
+    int peak = 0;
+    double renderNs = 0, worstNs = 0;
+    bool silentOk = true;
+    long loudBlocks = 0;
+    long allocationsBefore = allocations;
+    while (simMillis < (unsigned long)seconds * 1000)
+    {
+        // One block of game time: the sequencer steps every ms
+        for (long ms = 0; ms < blockMs; ++ms)
+        {
+            script(audio, simMillis);
+            simMillis++;
+            audio.update();
+        }
+
+        Clock::time_point t0 = Clock::now();
+        int rendered = synth.render();
+        Clock::time_point t1 = Clock::now();
+        double ns = std::chrono::duration<double, std::nano>(t1 - t0).count();
+        if (rendered > 0)
+        {
+            renderNs += ns;
+            worstNs = fmax(worstNs, ns / rendered);
+        }
+
+        // The DMA side takes one block per block period
+        if (const int16_t *block = synth.frontBlock())
+        {
+            int blockPeak = 0;
+            for (int i = 0; i < SYNTH_BLOCK_SAMPLES; ++i)
+            {
+                int v = abs(block[i]);
+                blockPeak = max(blockPeak, v);
+                if (v >= 32767)
+                    clipped++;
+                putLE(wav, (uint16_t)block[i], 2);
+            }
+            peak = max(peak, blockPeak);
+            unsigned long blockStart = (unsigned long)blocks * blockMs;
+            unsigned long phase = blockStart % 10000;
+            if (phase >= 9600 || phase < 400) // Nothing scripted here
+                silentOk = silentOk && blockPeak == 0;
+            if (blockPeak > 1000)
+                loudBlocks++;
+            samples += SYNTH_BLOCK_SAMPLES;
+            blocks++;
+            synth.popBlock();
+        }
+    }
+    long renderAllocations = allocations - allocationsBefore;
+
+    fseek(wav, 0, SEEK_SET);
+    writeWavHeader(wav, samples);
+    fclose(wav);
+
+    double meanNs = renderNs / blocks;
+    double blockNs = blockMs * 1e6;
+    printf("%ld blocks of %d samples at %u Hz written to %s\n", blocks, SYNTH_BLOCK_SAMPLES,
+           (unsigned)SYNTH_SAMPLE_RATE, path);
+    printf("synthesis: %.0f ns/block mean, %.0f ns worst = %.3f%% of a core at real time\n", meanNs, worstNs,
+           100.0 * meanNs / blockNs);
+    printf("peak %d, clipped samples %ld, blocks with sound %ld\n", peak, clipped, loudBlocks);
+    printf("allocations while rendering: %ld\n", renderAllocations);
+    printf("silent where nothing plays: %s\n", silentOk ? "yes" : "NO");
+    bool ok = renderAllocations == 0 && silentOk && loudBlocks > blocks / 10;
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,128 @@
+// bench_timestep.cpp - Fixed-timestep determinism across frame rates.
+// Plays the same scripted game with update()/draw() called at 60, 30, 20
+// and 10 Hz and on a jittery schedule. Input changes every 100 ms and every
+// schedule has a frame exactly on those boundaries, so each tick sees the
+// same input. At whole seconds the tick accumulator is empty, so the
+// rendered frame and score there must match whatever the frame rate was.
+//
+// Usage: bench_timestep [seconds]
+
+#include <Adafruit_SSD1306.h>
+#include "AstroLib.h"
+#include <stdio.h>
+#include <vector>
+
+static unsigned long simMillis = 0;
+static unsigned long simClock() { return simMillis; }
+
+struct Checkpoint {
+    uint32_t frameHash;
+    int score;
+    GameState state;
+};
+
+static int bestScore = 0;
+
+const unsigned long INPUT_SEGMENT_MS = 100;
+
+// Input for segment k of the script: held for every update in ((k-1) * 100 ms, k * 100 ms]
+static void scriptedInput(long segment, int &joyX, int &joyY, bool &fire)
+{
+    uint32_t h = (uint32_t)(segment / 8) * 2654435761u; // Stick moves every 800 ms
+    h ^= h >> 15;
+    joyX = (int)(h % 4096);
+    joyY = (int)((h >> 12) % 4096);
+    fire = segment & 1; // Tap fire every other segment
+}
+
+static uint32_t hashBuffer(const uint8_t *buffer)
+{
+    uint32_t h = 2166136261u; // FNV-1a
+    for (int i = 0; i < SCREEN_WIDTH * SCREEN_HEIGHT / 8; ++i)
+        h = (h ^ buffer[i]) * 16777619u;
+    return h;
+}
+
+// Frame intervals in ms, cycled; each schedule sums to 1000 ms per second
+static std::vector<Checkpoint> play(long seconds, const std::vector<int> &pattern, bool jitter)
+{
+    Adafruit_SSD1306 display(SCREEN_WIDTH, SCREEN_HEIGHT, &Wire, -1);
+    display.begin(SSD1306_SWITCHCAPVCC, 0x3C);
+    randomSeed(2024);
+    simMillis = 0;
+
+    AstroLib game(display);
+    game.attachTimeSource(simClock);
+    game.begin(25);
+
+    std::vector<Checkpoint> checkpoints;
+    uint32_t jitterSeed = 99;
+    size_t step = 0;
+    long segmentsPerSecond = 1000 / INPUT_SEGMENT_MS;
+    for (long segment = 1; segment <= seconds * segmentsPerSecond; ++segment)
+    {
+        int joyX, joyY;
+        bool fire;
+        scriptedInput(segment, joyX, joyY, fire);
+        unsigned long boundary = segment * INPUT_SEGMENT_MS;
+        while (simMillis < boundary)
+        {
+            unsigned long dt;
+            if (jitter)
+            {
+                jitterSeed = jitterSeed * 1664525u + 1013904223u;
+                dt = 5 + (jitterSeed >> 16) % 56; // 5..60 ms
+            }
+            else
+                dt = pattern[step++ % pattern.size()];
+            simMillis = min(simMillis + dt, boundary);
+            game.update(joyX, joyY, fire);
+            game.draw();
+            bestScore = max(bestScore, game.getScore());
+        }
+        if (segment % segmentsPerSecond)
+            continue;
+        Checkpoint c = {hashBuffer(display.getBuffer()), game.getScore(), game.getCurrentState()};
+        checkpoints.push_back(c);
+    }
+    return checkpoints;
+}
+
+int main(int argc, char **argv)
+{
+    long seconds = (argc > 1) ? atol(argv[1]) : 600;
+    if (seconds <= 0)
+        seconds = 1;
+
+    struct Schedule {
+        const char *name;
+        std::vector<int> pattern;
+        bool jitter;
+    };
+    std::vector<Schedule> schedules = {
+        {"30 Hz", {33, 33, 34}, false},
+        {"60 Hz", {17, 17, 16}, false},
+        {"20 Hz", {50}, false},
+        {"10 Hz", {100}, false},
+        {"jitter 5-60 ms", {}, true},
+    };
+
+    std::vector<Checkpoint> reference = play(seconds, schedules[0].pattern, false);
+    printf("best score in the scripted run: %d\n", bestScore);
+    bool ok = true;
+    for (size_t s = 0; s < schedules.size(); ++s)
+    {
+        std::vector<Checkpoint> run = (s == 0) ? reference : play(seconds, schedules[s].pattern, schedules[s].jitter);
+        long differing = 0;
+        for (long i = 0; i < seconds; ++i)
+        {
+            if (run[i].frameHash != reference[i].frameHash || run[i].score != reference[i].score ||
+                run[i].state != reference[i].state)
+                differing++;
+        }
+        printf("%-15s %ld s simulated, checkpoints differing from 30 Hz: %ld\n",
+               schedules[s].name, seconds, differing);
+        ok = ok && differing == 0;
+    }
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,108 @@
+// bench_trig.cpp - accuracy and throughput of the FastTrig tables vs libm.
+//
+// Usage: bench_trig [iterations]
+
+#include "FastTrig.h"
+#include <chrono>
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+typedef std::chrono::steady_clock Clock;
+
+static double nsPer(Clock::duration d, long n)
+{
+    return std::chrono::duration<double, std::nano>(d).count() / n;
+}
+
+int main(int argc, char **argv)
+{
+    long iterations = (argc > 1) ? atol(argv[1]) : 20000000;
+    if (iterations <= 0)
+        iterations = 1;
+
+    // --- Accuracy: every representable angle ---
+    double maxSinErr = 0;
+    for (long a = 0; a < 65536; ++a)
+    {
+        double exact = sin(bangleToRadians((BAngle)a));
+        float s, c;
+        sinCos((BAngle)a, s, c);
+        maxSinErr = fmax(maxSinErr, fabs(s - exact));
+        maxSinErr = fmax(maxSinErr, fabs(c - cos(bangleToRadians((BAngle)a))));
+    }
+
+    // atan2 over a ring of vectors at several magnitudes
+    double maxAtanErr = 0; // In BAngle units
+    for (int mag = 1; mag <= 1000000; mag *= 10)
+    {
+        for (int step = 0; step < 4096; ++step)
+        {
+            double theta = step * (2 * M_PI / 4096);
+            int32_t x = (int32_t)lround(cos(theta) * mag * 1000);
+            int32_t y = (int32_t)lround(sin(theta) * mag * 1000);
+            double exact = atan2((double)y, (double)x) * (65536 / (2 * M_PI));
+            double err = fabs((double)(int16_t)(fastAtan2(y, x) - (BAngle)(int32_t)lround(exact)));
+            maxAtanErr = fmax(maxAtanErr, err);
+        }
+    }
+
+    printf("sin/cos max error: %.2e (table: 1024 steps/turn, interpolated)\n", maxSinErr);
+    printf("atan2   max error: %.1f BAngle units (%.4f deg)\n", maxAtanErr, maxAtanErr * 360.0 / 65536);
+
+    // --- Throughput ---
+    volatile float sink = 0;
+    float acc = 0;
+    uint32_t angle = 12345;
+
+    Clock::time_point t0 = Clock::now();
+    for (long i = 0; i < iterations; ++i)
+    {
+        float r = (angle & 0xFFFF) * (6.2831853f / 65536);
+        acc += (float)cos(r) + (float)sin(r); // What the game used to call
+        angle += 40503;
+    }
+    Clock::time_point t1 = Clock::now();
+    sink = acc;
+
+    acc = 0;
+    Clock::time_point t2 = Clock::now();
+    for (long i = 0; i < iterations; ++i)
+    {
+        float s, c;
+        sinCos((BAngle)angle, s, c);
+        acc += c + s;
+        angle += 40503;
+    }
+    Clock::time_point t3 = Clock::now();
+    sink = acc;
+
+    acc = 0;
+    Clock::time_point t4 = Clock::now();
+    for (long i = 0; i < iterations; ++i)
+    {
+        int32_t x = (int32_t)(angle & 0xFFF) - 2048, y = (int32_t)((angle >> 12) & 0xFFF) - 2048;
+        acc += (float)atan2((float)y, (float)x);
+        angle += 40503;
+    }
+    Clock::time_point t5 = Clock::now();
+    sink = acc;
+
+    acc = 0;
+    Clock::time_point t6 = Clock::now();
+    for (long i = 0; i < iterations; ++i)
+    {
+        int32_t x = (int32_t)(angle & 0xFFF) - 2048, y = (int32_t)((angle >> 12) & 0xFFF) - 2048;
+        acc += fastAtan2(y, x);
+        angle += 40503;
+    }
+    Clock::time_point t7 = Clock::now();
+    sink = acc;
+    (void)sink;
+
+    double libSinCos = nsPer(t1 - t0, iterations), fastSinCos = nsPer(t3 - t2, iterations);
+    double libAtan = nsPer(t5 - t4, iterations), fastAtan = nsPer(t7 - t6, iterations);
+    printf("sin+cos: libm %6.2f ns  table %6.2f ns  (%.1fx)\n", libSinCos, fastSinCos, libSinCos / fastSinCos);
+    printf("atan2:   libm %6.2f ns  table %6.2f ns  (%.1fx)\n", libAtan, fastAtan, libAtan / fastAtan);
+    return 0;
+}
@@ -0,0 +1,265 @@
+#include "Adafruit_SSD1306.h"
+
+// --- Adafruit_GFX ---
+
+Adafruit_GFX::Adafruit_GFX(int16_t w, int16_t h) : WIDTH(w), HEIGHT(h), _width(w), _height(h),
+                                                   cursor_x(0), cursor_y(0), textcolor(1), textsize(1), rotation(0)
+{
+}
+
+void Adafruit_GFX::writeLine(int16_t x0, int16_t y0, int16_t x1, int16_t y1, uint16_t color)
+{
+    // Bresenham, same structure as the real writeLine()
+    bool steep = abs(y1 - y0) > abs(x1 - x0);
+    if (steep)
+    {
+        std::swap(x0, y0);
+        std::swap(x1, y1);
+    }
+    if (x0 > x1)
+    {
+        std::swap(x0, x1);
+        std::swap(y0, y1);
+    }
+    int16_t dx = x1 - x0;
+    int16_t dy = abs(y1 - y0);
+    int16_t err = dx / 2;
+    int16_t ystep = (y0 < y1) ? 1 : -1;
+    for (; x0 <= x1; x0++)
+    {
+        if (steep)
+            writePixel(y0, x0, color);
+        else
+            writePixel(x0, y0, color);
+        err -= dy;
+        if (err < 0)
+        {
+            y0 += ystep;
+            err += dx;
+        }
+    }
+}
+
+void Adafruit_GFX::drawFastVLine(int16_t x, int16_t y, int16_t h, uint16_t color)
+{
+    writeLine(x, y, x, y + h - 1, color);
+}
+
+void Adafruit_GFX::drawFastHLine(int16_t x, int16_t y, int16_t w, uint16_t color)
+{
+    writeLine(x, y, x + w - 1, y, color);
+}
+
+void Adafruit_GFX::fillRect(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color)
+{
+    for (int16_t i = x; i < x + w; i++)
+        drawFastVLine(i, y, h, color);
+}
+
+void Adafruit_GFX::drawLine(int16_t x0, int16_t y0, int16_t x1, int16_t y1, uint16_t color)
+{
+    if (x0 == x1)
+    {
+        if (y0 > y1)
+            std::swap(y0, y1);
+        drawFastVLine(x0, y0, y1 - y0 + 1, color);
+    }
+    else if (y0 == y1)
+    {
+        if (x0 > x1)
+            std::swap(x0, x1);
+        drawFastHLine(x0, y0, x1 - x0 + 1, color);
+    }
+    else
+    {
+        writeLine(x0, y0, x1, y1, color);
+    }
+}
+
+void Adafruit_GFX::drawTriangle(int16_t x0, int16_t y0, int16_t x1, int16_t y1, int16_t x2, int16_t y2, uint16_t color)
+{
+    drawLine(x0, y0, x1, y1, color);
+    drawLine(x1, y1, x2, y2, color);
+    drawLine(x2, y2, x0, y0, color);
+}
+
+void Adafruit_GFX::drawChar(int16_t x, int16_t y, unsigned char c, uint16_t color, uint16_t bg, uint8_t size)
+{
+    (void)bg;
+    if (c == ' ')
+        return;
+    // Stand-in glyph: a fixed bit pattern per character, 5 columns x 7 rows
+    for (int8_t i = 0; i < 5; i++)
+    {
+        uint8_t line = (uint8_t)((c * 37u + i * 11u) | 0x41u) & 0x7F;
+        for (int8_t j = 0; j < 7; j++, line >>= 1)
+        {
+            if (line & 1)
+            {
+                if (size == 1)
+                    writePixel(x + i, y + j, color);
+                else
+                    fillRect(x + i * size, y + j * size, size, size, color);
+            }
+        }
+    }
+}
+
+size_t Adafruit_GFX::write(uint8_t c)
+{
+    if (c == '\n')
+    {
+        cursor_x = 0;
+        cursor_y += textsize * 8;
+    }
+    else if (c != '\r')
+    {
+        drawChar(cursor_x, cursor_y, c, textcolor, textcolor, textsize);
+        cursor_x += textsize * 6;
+    }
+    return 1;
+}
+
+void Adafruit_GFX::getTextBounds(const char *str, int16_t x, int16_t y, int16_t *x1, int16_t *y1, uint16_t *w, uint16_t *h)
+{
+    *x1 = x;
+    *y1 = y;
+    *w = (uint16_t)(strlen(str) * 6 * textsize);
+    *h = (uint16_t)(8 * textsize);
+}
+
+void Adafruit_GFX::getTextBounds(const String &str, int16_t x, int16_t y, int16_t *x1, int16_t *y1, uint16_t *w, uint16_t *h)
+{
+    getTextBounds(str.c_str(), x, y, x1, y1, w, h);
+}
+
+// --- Adafruit_SSD1306 ---
+
+Adafruit_SSD1306::Adafruit_SSD1306(uint8_t w, uint8_t h, TwoWire *twi, int8_t rst_pin)
+    : Adafruit_GFX(w, h), wire(twi), buffer(NULL), panel(NULL), frames(0),
+      pendingCommand(0), pendingArgs(0), pageStart(0), pageEnd(0), colStart(0), colEnd(0), page(0), col(0)
+{
+    (void)rst_pin;
+    buffer = new uint8_t[w * ((h + 7) / 8)];
+    panel = new uint8_t[w * ((h + 7) / 8)];
+    memset(panel, 0, w * ((h + 7) / 8));
+    clearDisplay();
+    wire->attachDataSink(receiveData, this);
+}
+
+Adafruit_SSD1306::~Adafruit_SSD1306()
+{
+    delete[] buffer;
+    delete[] panel;
+}
+
+bool Adafruit_SSD1306::begin(uint8_t switchvcc, uint8_t i2caddr)
+{
+    (void)switchvcc;
+    (void)i2caddr;
+    return true;
+}
+
+void Adafruit_SSD1306::clearDisplay()
+{
+    memset(buffer, 0, WIDTH * ((HEIGHT + 7) / 8));
+}
+
+void Adafruit_SSD1306::drawPixel(int16_t x, int16_t y, uint16_t color)
+{
+    if ((x >= 0) && (x < width()) && (y >= 0) && (y < height()))
+    {
+        switch (getRotation())
+        {
+        case 1:
+            std::swap(x, y);
+            x = WIDTH - x - 1;
+            break;
+        case 2:
+            x = WIDTH - x - 1;
+            y = HEIGHT - y - 1;
+            break;
+        case 3:
+            std::swap(x, y);
+            y = HEIGHT - y - 1;
+            break;
+        }
+        switch (color)
+        {
+        case SSD1306_WHITE:
+            buffer[x + (y / 8) * WIDTH] |= (1 << (y & 7));
+            break;
+        case SSD1306_BLACK:
+            buffer[x + (y / 8) * WIDTH] &= ~(1 << (y & 7));
+            break;
+        case SSD1306_INVERSE:
+            buffer[x + (y / 8) * WIDTH] ^= (1 << (y & 7));
+            break;
+        }
+    }
+}
+
+void Adafruit_SSD1306::display()
+{
+    // Page/column address setup (6 command bytes) plus the whole buffer
+    ssd1306_command(SSD1306_PAGEADDR);
+    ssd1306_command(0);
+    ssd1306_command(0xFF);
+    ssd1306_command(SSD1306_COLUMNADDR);
+    ssd1306_command(0);
+    ssd1306_command(WIDTH - 1);
+    wire->addBytes(WIDTH * ((HEIGHT + 7) / 8));
+    memcpy(panel, buffer, WIDTH * ((HEIGHT + 7) / 8));
+    frames++;
+}
+
+void Adafruit_SSD1306::ssd1306_command(uint8_t c)
+{
+    wire->addBytes(3); // Address + control byte + command byte
+
+    if (pendingArgs > 0)
+    {
+        uint8_t pages = (uint8_t)((HEIGHT + 7) / 8);
+        if (pendingCommand == SSD1306_PAGEADDR)
+        {
+            if (pendingArgs == 2)
+                pageStart = page = (uint8_t)(c % pages);
+            else
+                pageEnd = (uint8_t)((c >= pages) ? pages - 1 : c);
+        }
+        else
+        {
+            if (pendingArgs == 2)
+                colStart = col = c;
+            else
+                colEnd = c;
+        }
+        pendingArgs--;
+    }
+    else if (c == SSD1306_PAGEADDR || c == SSD1306_COLUMNADDR)
+    {
+        pendingCommand = c;
+        pendingArgs = 2;
+    }
+}
+
+void Adafruit_SSD1306::receiveData(void *context, uint8_t data)
+{
+    Adafruit_SSD1306 *self = (Adafruit_SSD1306 *)context;
+    self->panel[self->page * self->WIDTH + self->col] = data;
+    // Horizontal addressing: advance column, wrap to next page in the window
+    if (self->col >= self->colEnd)
+    {
+        self->col = self->colStart;
+        self->page = (self->page >= self->pageEnd) ? self->pageStart : self->page + 1;
+    }
+    else
+    {
+        self->col++;
+    }
+}
+
+bool Adafruit_SSD1306::panelMatchesBuffer() const
+{
+    return memcmp(panel, buffer, WIDTH * ((HEIGHT + 7) / 8)) == 0;
+}
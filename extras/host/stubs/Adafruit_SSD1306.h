@@ -0,0 +1,48 @@
+// Adafruit_SSD1306.h - host stand-in for the SSD1306 OLED driver.
+// Keeps a real page-layout framebuffer plus a model of the panel's own RAM:
+// display() and windowed writes (PAGEADDR/COLUMNADDR + data over Wire)
+// update the model, so tests can check what the panel would show.
+#ifndef HOST_ADAFRUIT_SSD1306_H
+#define HOST_ADAFRUIT_SSD1306_H
+
+#include "Adafruit_GFX.h"
+#include "Wire.h"
+
+#define SSD1306_BLACK 0
+#define SSD1306_WHITE 1
+#define SSD1306_INVERSE 2
+#define SSD1306_SWITCHCAPVCC 0x02
+#define SSD1306_COLUMNADDR 0x21
+#define SSD1306_PAGEADDR 0x22
+
+class Adafruit_SSD1306 : public Adafruit_GFX {
+public:
+    Adafruit_SSD1306(uint8_t w, uint8_t h, TwoWire *twi = &Wire, int8_t rst_pin = -1);
+    ~Adafruit_SSD1306();
+
+    bool begin(uint8_t switchvcc = SSD1306_SWITCHCAPVCC, uint8_t i2caddr = 0x3C);
+    void display();
+    void clearDisplay();
+    void drawPixel(int16_t x, int16_t y, uint16_t color) override;
+    void ssd1306_command(uint8_t c);
+    uint8_t *getBuffer() { return buffer; }
+
+    // Host only: number of display() calls so far
+    unsigned long framesPushed() const { return frames; }
+    // Host only: does the modelled panel show exactly the framebuffer?
+    bool panelMatchesBuffer() const;
+
+private:
+    TwoWire *wire;
+    uint8_t *buffer;
+    uint8_t *panel; // Modelled controller RAM
+    unsigned long frames;
+
+    // Controller addressing state (horizontal addressing mode)
+    uint8_t pendingCommand, pendingArgs;
+    uint8_t pageStart, pageEnd, colStart, colEnd, page, col;
+
+    static void receiveData(void *context, uint8_t data);
+};
+
+#endif // HOST_ADAFRUIT_SSD1306_H
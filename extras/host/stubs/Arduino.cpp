@@ -0,0 +1,152 @@
+#include "Arduino.h"
+#include "Wire.h"
+#include <chrono>
+#include <mutex>
+#include <stdio.h>
+
+HardwareSerial Serial;
+TwoWire Wire;
+
+// --- Time ---
+static const std::chrono::steady_clock::time_point startTime = std::chrono::steady_clock::now();
+
+unsigned long millis()
+{
+    return (unsigned long)std::chrono::duration_cast<std::chrono::milliseconds>(
+               std::chrono::steady_clock::now() - startTime).count();
+}
+
+unsigned long micros()
+{
+    return (unsigned long)std::chrono::duration_cast<std::chrono::microseconds>(
+               std::chrono::steady_clock::now() - startTime).count();
+}
+
+void delay(unsigned long) {}
+
+// --- Random ---
+// Same shape as the AVR core: a seedable global generator with modulo ranges.
+static uint32_t randomState = 1;
+
+static uint32_t nextRandom()
+{
+    randomState = randomState * 1103515245u + 12345u;
+    return randomState >> 1;
+}
+
+long random(long howbig)
+{
+    if (howbig <= 0)
+        return 0;
+    return (long)(nextRandom() % (uint32_t)howbig);
+}
+
+long random(long howsmall, long howbig)
+{
+    if (howsmall >= howbig)
+        return howsmall;
+    return howsmall + random(howbig - howsmall);
+}
+
+void randomSeed(unsigned long seed)
+{
+    if (seed != 0)
+        randomState = (uint32_t)seed;
+}
+
+// --- GPIO / Tone ---
+static int pinLevels[64];
+static bool pinLevelsInitialized = false;
+
+void pinMode(uint8_t pin, uint8_t mode)
+{
+    if (!pinLevelsInitialized)
+    {
+        for (int i = 0; i < 64; ++i)
+            pinLevels[i] = HIGH; // Pulled up: buttons read as released
+        pinLevelsInitialized = true;
+    }
+    (void)pin;
+    (void)mode;
+}
+
+int digitalRead(uint8_t pin)
+{
+    if (!pinLevelsInitialized || pin >= 64)
+        return HIGH;
+    return pinLevels[pin];
+}
+
+void hostSetDigitalPin(uint8_t pin, int value)
+{
+    pinMode(pin, INPUT_PULLUP);
+    if (pin < 64)
+        pinLevels[pin] = value;
+}
+
+// Written from the audio sequencer thread, read from the benchmark. Capped
+// so long benchmark runs that never clear it stay small.
+static std::mutex toneLogMutex;
+static std::vector<HostToneEvent> toneLog;
+static const size_t TONE_LOG_LIMIT = 1 << 18;
+
+static void logTone(uint8_t pin, unsigned int frequency)
+{
+    std::lock_guard<std::mutex> lock(toneLogMutex);
+    if (toneLog.size() >= TONE_LOG_LIMIT)
+        return;
+    HostToneEvent event = {micros(), pin, frequency};
+    toneLog.push_back(event);
+}
+
+void tone(uint8_t pin, unsigned int frequency, unsigned long) { logTone(pin, frequency); }
+void noTone(uint8_t pin) { logTone(pin, 0); }
+
+std::vector<HostToneEvent> hostToneEvents()
+{
+    std::lock_guard<std::mutex> lock(toneLogMutex);
+    return toneLog;
+}
+
+void hostClearToneEvents()
+{
+    std::lock_guard<std::mutex> lock(toneLogMutex);
+    toneLog.clear();
+}
+
+// --- Print ---
+size_t Print::write(const char *s)
+{
+    size_t n = 0;
+    while (s && *s)
+        n += write((uint8_t)*s++);
+    return n;
+}
+
+size_t Print::print(long v)
+{
+    char buf[24];
+    snprintf(buf, sizeof(buf), "%ld", v);
+    return write(buf);
+}
+
+size_t Print::print(unsigned long v)
+{
+    char buf[24];
+    snprintf(buf, sizeof(buf), "%lu", v);
+    return write(buf);
+}
+
+size_t Print::print(double v, int digits)
+{
+    char buf[48];
+    snprintf(buf, sizeof(buf), "%.*f", digits, v);
+    return write(buf);
+}
+
+size_t HardwareSerial::write(uint8_t c)
+{
+    if (enabled)
+        fputc(c, stdout);
+    return 1;
+}
@@ -0,0 +1,107 @@
+// Arduino.h - host (Linux) stand-in for the subset of the ESP32 Arduino core
+// that AstroLib uses. Only meant for the headless benchmark build.
+#ifndef HOST_ARDUINO_H
+#define HOST_ARDUINO_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <algorithm>
+#include <cmath>
+#include <string>
+#include <vector>
+
+using std::max;
+using std::min;
+
+#define HIGH 0x1
+#define LOW 0x0
+#define INPUT 0x01
+#define OUTPUT 0x03
+#define INPUT_PULLUP 0x05
+
+#define F(str) (str)
+#define PROGMEM
+#define pgm_read_byte(addr) (*(const uint8_t *)(addr))
+
+typedef bool boolean;
+typedef uint8_t byte;
+
+// --- Time ---
+unsigned long millis();
+unsigned long micros();
+void delay(unsigned long ms); // No-op on the host so benchmarks never sleep
+
+// --- Random ---
+long random(long howbig);
+long random(long howsmall, long howbig);
+void randomSeed(unsigned long seed);
+
+// --- GPIO / Tone ---
+void pinMode(uint8_t pin, uint8_t mode);
+int digitalRead(uint8_t pin);
+void hostSetDigitalPin(uint8_t pin, int value); // Host only: drive a pin level
+void tone(uint8_t pin, unsigned int frequency, unsigned long duration = 0);
+void noTone(uint8_t pin);
+
+// Host only: every tone()/noTone() call, in order, for checking sound timing
+struct HostToneEvent {
+    unsigned long micros;
+    uint8_t pin;
+    unsigned int frequency; // 0 = noTone()
+};
+std::vector<HostToneEvent> hostToneEvents();
+void hostClearToneEvents();
+
+// --- String ---
+class String {
+public:
+    String(const char *s = "") : str(s ? s : "") {}
+    String(int v) : str(std::to_string(v)) {}
+    String(long v) : str(std::to_string(v)) {}
+    String(unsigned long v) : str(std::to_string(v)) {}
+    String &operator+=(const char *s) { str += s; return *this; }
+    String &operator+=(const String &s) { str += s.str; return *this; }
+    String &operator+=(int v) { str += std::to_string(v); return *this; }
+    String &operator+=(long v) { str += std::to_string(v); return *this; }
+    const char *c_str() const { return str.c_str(); }
+    unsigned int length() const { return (unsigned int)str.size(); }
+
+private:
+    std::string str;
+};
+
+// --- Print / Serial ---
+class Print {
+public:
+    virtual ~Print() {}
+    virtual size_t write(uint8_t c) = 0;
+    size_t write(const char *s);
+    size_t print(const char *s) { return write(s); }
+    size_t print(const String &s) { return write(s.c_str()); }
+    size_t print(char c) { return write((uint8_t)c); }
+    size_t print(int v) { return print((long)v); }
+    size_t print(unsigned int v) { return print((unsigned long)v); }
+    size_t print(long v);
+    size_t print(unsigned long v);
+    size_t print(double v, int digits = 2);
+    size_t println() { return write('\n'); }
+    template <typename T> size_t println(const T &v) { size_t n = print(v); return n + println(); }
+};
+
+class HardwareSerial : public Print {
+public:
+    HardwareSerial() : enabled(false) {}
+    void begin(unsigned long) { enabled = true; } // Output stays silent until begin()
+    size_t write(uint8_t c) override;
+    using Print::write;
+
+private:
+    bool enabled;
+};
+
+extern HardwareSerial Serial;
+
+#endif // HOST_ARDUINO_H
@@ -0,0 +1,132 @@
+#include "Preferences.h"
+#include <atomic>
+#include <stdio.h>
+
+static std::string backingFile;
+static std::atomic<unsigned long> writeCount(0); // Bumped from the render thread when pipelined
+static unsigned long bytesWritten = 0;
+static bool tearPending = false;
+static size_t tearBytes = 0;
+static std::atomic<bool> failWrites(false); // Read from the render thread when pipelined
+
+void Preferences::hostUseFile(const char *path) { backingFile = path ? path : ""; }
+unsigned long Preferences::hostWriteCount() { return writeCount; }
+unsigned long Preferences::hostBytesWritten() { return bytesWritten; }
+
+void Preferences::hostFailWrites(bool fail) { failWrites = fail; }
+
+void Preferences::hostTearNextWrite(size_t bytes)
+{
+    tearPending = true;
+    tearBytes = bytes;
+}
+
+bool Preferences::begin(const char *name, bool readOnly)
+{
+    (void)readOnly;
+    ns = name ? name : "";
+    file = backingFile;
+    opened = true;
+    load();
+    return true;
+}
+
+int32_t Preferences::getInt(const char *key, int32_t defaultValue)
+{
+    int32_t value;
+    if (getBytesLength(key) != sizeof(value) || getBytes(key, &value, sizeof(value)) != sizeof(value))
+        return defaultValue;
+    return value;
+}
+
+size_t Preferences::putInt(const char *key, int32_t value)
+{
+    return put(key, &value, sizeof(value));
+}
+
+size_t Preferences::getBytesLength(const char *key)
+{
+    std::map<std::string, std::vector<uint8_t> >::const_iterator it = values.find(ns + "/" + key);
+    return (opened && it != values.end()) ? it->second.size() : 0;
+}
+
+size_t Preferences::getBytes(const char *key, void *buf, size_t maxLen)
+{
+    std::map<std::string, std::vector<uint8_t> >::const_iterator it = values.find(ns + "/" + key);
+    if (!opened || it == values.end() || it->second.size() > maxLen)
+        return 0;
+    memcpy(buf, it->second.data(), it->second.size());
+    return it->second.size();
+}
+
+size_t Preferences::putBytes(const char *key, const void *value, size_t len)
+{
+    return put(key, value, len);
+}
+
+size_t Preferences::put(const char *key, const void *value, size_t len)
+{
+    if (!opened)
+        return 0;
+    writeCount++;
+    if (failWrites)
+        return 0;
+    std::vector<uint8_t> &slot = values[ns + "/" + key];
+    if (tearPending)
+    {
+        // New bytes up to the tear, whatever was there before after it
+        tearPending = false;
+        size_t n = (tearBytes < len) ? tearBytes : len;
+        slot.resize(len, 0xFF);
+        memcpy(slot.data(), value, n);
+        bytesWritten += n;
+        save();
+        return n;
+    }
+    slot.assign((const uint8_t *)value, (const uint8_t *)value + len);
+    bytesWritten += len;
+    save();
+    return len;
+}
+
+// File format: per value, key length (u16), key, value length (u16), value
+void Preferences::load()
+{
+    if (file.empty())
+        return;
+    values.clear();
+    FILE *f = fopen(file.c_str(), "rb");
+    if (!f)
+        return;
+    uint16_t keyLength, valueLength;
+    while (fread(&keyLength, sizeof(keyLength), 1, f) == 1)
+    {
+        std::string key(keyLength, '\0');
+        if (fread(&key[0], 1, keyLength, f) != keyLength || fread(&valueLength, sizeof(valueLength), 1, f) != 1)
+            break;
+        std::vector<uint8_t> value(valueLength);
+        if (fread(value.data(), 1, valueLength, f) != valueLength)
+            break;
+        values[key] = value;
+    }
+    fclose(f);
+}
+
+void Preferences::save()
+{
+    if (file.empty())
+        return;
+    FILE *f = fopen(file.c_str(), "wb");
+    if (!f)
+        return;
+    for (std::map<std::string, std::vector<uint8_t> >::const_iterator it = values.begin(); it != values.end(); ++it)
+    {
+        uint16_t keyLength = (uint16_t)it->first.size();
+        uint16_t valueLength = (uint16_t)it->second.size();
+        fwrite(&keyLength, sizeof(keyLength), 1, f);
+        fwrite(it->first.data(), 1, keyLength, f);
+        fwrite(&valueLength, sizeof(valueLength), 1, f);
+        fwrite(it->second.data(), 1, valueLength, f);
+    }
+    fclose(f);
+}
@@ -0,0 +1,48 @@
+// Preferences.h - host stand-in for the ESP32 NVS Preferences API.
+// Values live in memory for the lifetime of the instance, or in a file
+// shared by every instance after hostUseFile(). Every put counts as one
+// flash write, a write can be made to tear as if power failed mid-way, and
+// the store can be made to refuse writes as if the partition were full.
+#ifndef HOST_PREFERENCES_H
+#define HOST_PREFERENCES_H
+
+#include "Arduino.h"
+#include <map>
+#include <string>
+#include <vector>
+
+class Preferences {
+public:
+    Preferences() : opened(false) {}
+    bool begin(const char *name, bool readOnly = false);
+    void end() { opened = false; }
+
+    int32_t getInt(const char *key, int32_t defaultValue = 0);
+    size_t putInt(const char *key, int32_t value);
+    size_t getBytesLength(const char *key);
+    size_t getBytes(const char *key, void *buf, size_t maxLen);
+    size_t putBytes(const char *key, const void *value, size_t len);
+
+    // --- Host only ---
+    // Back instances begun from now on with `path` (NULL: memory again)
+    static void hostUseFile(const char *path);
+    static unsigned long hostWriteCount();
+    static unsigned long hostBytesWritten();
+    // The next put stores only its first `bytes` bytes over the old value,
+    // as if power failed during the write
+    static void hostTearNextWrite(size_t bytes);
+    // Puts store nothing and return 0 (still counted as writes) until cleared
+    static void hostFailWrites(bool fail);
+
+private:
+    bool opened;
+    std::string ns;
+    std::string file; // Empty: memory only
+    std::map<std::string, std::vector<uint8_t> > values;
+
+    size_t put(const char *key, const void *value, size_t len);
+    void load();
+    void save();
+};
+
+#endif // HOST_PREFERENCES_H
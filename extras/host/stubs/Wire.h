@@ -0,0 +1,56 @@
+// Wire.h - host stand-in for the Arduino I2C driver.
+// Nothing is transmitted; the bus counts the bytes it would have sent and
+// forwards SSD1306 data streams (control byte 0x40) to an attached panel model.
+#ifndef HOST_WIRE_H
+#define HOST_WIRE_H
+
+#include "Arduino.h"
+
+class TwoWire {
+public:
+    // Receives display data bytes (host only)
+    typedef void (*DataSink)(void *context, uint8_t data);
+
+    TwoWire() : bytesSent(0), txBytes(0), dataMode(false), sink(NULL), sinkContext(NULL) {}
+    void begin() {}
+    void setClock(uint32_t) {}
+    void beginTransmission(uint8_t)
+    {
+        bytesSent++; // Address byte
+        txBytes = 0;
+        dataMode = false;
+    }
+    size_t write(uint8_t c)
+    {
+        bytesSent++;
+        if (txBytes++ == 0)
+            dataMode = (c == 0x40);
+        else if (dataMode && sink)
+            sink(sinkContext, c);
+        return 1;
+    }
+    size_t write(const uint8_t *data, size_t len)
+    {
+        for (size_t i = 0; i < len; ++i)
+            write(data[i]);
+        return len;
+    }
+    uint8_t endTransmission(bool = true) { return 0; }
+
+    void attachDataSink(DataSink s, void *context) { sink = s; sinkContext = context; }
+
+    // Host only: running total of bytes clocked onto the bus
+    unsigned long bytesWritten() const { return bytesSent; }
+    void addBytes(unsigned long n) { bytesSent += n; }
+
+private:
+    unsigned long bytesSent;
+    size_t txBytes;
+    bool dataMode;
+    DataSink sink;
+    void *sinkContext;
+};
+
+extern TwoWire Wire;
+
+#endif // HOST_WIRE_H
@@ -0,0 +1,63 @@
+#ifndef ASTRO_CONFIG_H
+#define ASTRO_CONFIG_H
+
+#include "GameData.h"
+
+// --- Build Configurations ---
+// BasicAstroLib<Config> takes its panel size, pool capacities and the
+// tuning that depends on them from Config at compile time, so array sizes,
+// wrap bounds and HUD positions are constants in the generated code.
+// AstroLib is BasicAstroLib<DefaultConfig>. For another panel or density,
+// derive from DefaultConfig and redeclare only what differs:
+//
+//     struct MyConfig : DefaultConfig { static const int MAX_ASTEROIDS = 16; };
+//     BasicAstroLib<MyConfig> game(display);
+//
+// Constraints (checked by static_assert): WIDTH and HEIGHT are powers of
+// two, at most 256, and whole 16-pixel collision cells; pool sizes are at
+// most 65535 and PARTICLE_CAPACITY is a power of two. Everything else in
+// GameData.h is shared by every configuration.
+struct DefaultConfig {
+    // Panel
+    static const int WIDTH = SCREEN_WIDTH;
+    static const int HEIGHT = SCREEN_HEIGHT;
+
+    // Pool capacities
+    static const int MAX_BULLETS = ::MAX_BULLETS;
+    static const int MAX_ASTEROIDS = ::MAX_ASTEROIDS;
+    static const int PARTICLE_CAPACITY = ::PARTICLE_CAPACITY;
+
+    // Tuning
+    static const int STARTING_ASTEROIDS = ::STARTING_ASTEROIDS; // First wave; later waves add one per 500 points
+    static const int PARTICLE_BUDGET = ::PARTICLE_BUDGET;
+    static const int BULLET_LIFETIME = ::BULLET_LIFETIME;         // Reference frames
+    static constexpr float BULLET_SPEED = ::BULLET_SPEED;
+    static constexpr float ASTEROID_SPEED_MIN = ::ASTEROID_SPEED_MIN;
+    static constexpr float ASTEROID_SPEED_MAX = ::ASTEROID_SPEED_MAX;
+
+    // false: headless, for simulation only. The snapshot buffers, dirty
+    // regions, HUD caches and raster shrink to empty placeholders and
+    // draw() no longer compiles.
+    static const bool RENDERING = true;
+};
+
+// 128x32 SSD1306 panels: half the playfield, so fewer and slower rocks and
+// bullets that expire before crossing the screen twice
+struct Oled128x32Config : DefaultConfig {
+    static const int HEIGHT = 32;
+    static const int MAX_ASTEROIDS = 6;
+    static const int STARTING_ASTEROIDS = 2;
+    static const int BULLET_LIFETIME = 30;
+    static constexpr float ASTEROID_SPEED_MAX = 1.2f;
+};
+
+// 128x64 with crowded waves: bigger pools on every side
+struct DenseConfig : DefaultConfig {
+    static const int MAX_BULLETS = 8;
+    static const int MAX_ASTEROIDS = 40;
+    static const int PARTICLE_CAPACITY = 128;
+    static const int STARTING_ASTEROIDS = 6;
+    static const int PARTICLE_BUDGET = 96;
+};
+
+#endif // ASTRO_CONFIG_H
@@ -5,16 +5,85 @@
 #include <Adafruit_SSD1306.h>
 #include <cmath>
 #include <Preferences.h>
+#include <type_traits>
+#include <Wire.h>
 #include "GameData.h"       // Include shared data definitions FIRST
+#include "AstroConfig.h"
 #include "AudioEngine.h"    // Include the audio engine
+#include "CollisionGrid.h"
+#include "DirtyRegion.h"
+#include "EntityPool.h"
+#include "FrameRaster.h"
+#include "FastRandom.h"
+#include "FrameProfiler.h"
+#include "FrameSnapshot.h"
+#include "HudText.h"
+#include "InputLog.h"
+#include "Leaderboard.h"
+#include "ParticlePool.h"
+#include "SaveState.h"
 
-class AstroLib { // Renamed class
+#if defined(ESP32)
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
+#elif defined(ASTRO_HOST_BUILD)
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#endif
+
+const uint32_t RENDER_TASK_STACK = 4096; // Bytes (ESP32 FreeRTOS task)
+
+// Takes the place of a render-side member in a headless build
+// (Config::RENDERING false): no storage, and the few calls the simulation
+// side makes on it do nothing.
+struct NoRenderState {
+    NoRenderState() {}
+    explicit NoRenderState(const char *) {}
+    void markAll() {}
+};
+
+template <bool Rendering, typename T>
+struct RenderOnly {
+    typedef T type;
+};
+
+template <typename T>
+struct RenderOnly<false, T> {
+    typedef NoRenderState type;
+};
+
+// The game, built for one panel size and set of pool capacities (see
+// AstroConfig.h). Most sketches use AstroLib, the 128x64 default.
+template <typename Config>
+class BasicAstroLib {
 public:
-    AstroLib(Adafruit_SSD1306 &display); // Renamed constructor
+    typedef BasicFrameSnapshot<Config> Snapshot;
+    typedef BasicSaveState<Config> SaveState;
+
+    BasicAstroLib(Adafruit_SSD1306 &display); // Display must be Config::WIDTH x Config::HEIGHT
+    ~BasicAstroLib();
 
     // --- Configuration ---
     void attachFireButtonPin(int pin);
     void attachHyperspaceButtonPin(int pin);
+    void attachTimeSource(TimeSource source); // Defaults to millis()
+    // Simulation ticks per second (default SIM_TICK_RATE). update() runs as
+    // many fixed ticks as real time has covered and draw() interpolates
+    // between the last two, so gameplay speed does not depend on frame rate.
+    void setTickRate(int ticksPerSecond);
+    // Flush only changed page windows over I2C instead of the whole 1 KB
+    // framebuffer. Pass the same bus/address the display was begun with.
+    // The panel state belongs to the render side: false, and nothing
+    // attached, while the render task runs.
+    bool attachPartialFlush(TwoWire &wire, uint8_t i2cAddress);
+    // Play sounds through a PCM synthesizer (I2S/DAC) instead of the buzzer
+    // pin; see AudioEngine::attachSynth(). Call before begin().
+    void attachSynth(PcmSynth &synth);
+    // Caps the debris and exhaust particles updated and drawn per tick
+    // (default Config::PARTICLE_BUDGET, at most Config::PARTICLE_CAPACITY). Past the cap the
+    // oldest particles vanish early instead of the frame running long.
+    void setParticleBudget(int perTick);
 
     // --- Core Methods ---
     void begin(int audioPin);
@@ -25,11 +94,128 @@ public:
     int getHighScore();
     void resetHighScore();
 
+    // --- Leaderboard ---
+    // The best LEADERBOARD_SIZE final scores, kept in NVS. Game over only
+    // records a score in RAM; it is written to flash a few seconds later
+    // from the START or GAME_OVER screen, never during play. With the render
+    // task running (startRenderTask()) the render side does the write, so
+    // update() never waits on flash. Without it the write runs inside
+    // update(), and a flash stall delays that one menu frame.
+    int getLeaderboardCount();
+    int getLeaderboardScore(int rank); // 0 = best
+    void flushLeaderboard();           // Write pending scores now (e.g. before deep sleep)
+
+    // --- Pipelined Rendering ---
+    // Moves drawing and the display flush onto another core (a FreeRTOS task
+    // pinned to `core` on ESP32, a std::thread on the host). update() then
+    // only simulates and publishes a snapshot; the render side draws the
+    // newest one. draw() does nothing while the task runs. Returns false
+    // where there is no second core to use.
+    bool startRenderTask(int core = 0);
+    void stopRenderTask();
+    bool isPipelined();
+
+    // --- Recording & Replay ---
+    // Restarts at the START screen from `seed` and records the inputs and
+    // frame timing of every update() into `log` until stopRecording(),
+    // which appends the final stateChecksum().
+    void startRecording(InputLogWriter &log, uint32_t seed);
+    void stopRecording();
+    // Restarts from the log's header; each replayFrame() then repeats one
+    // recorded update() without reading the clock or the pins. Returns
+    // false once the log is exhausted. Replays never write the high score.
+    bool startReplay(InputLogReader &log);
+    bool replayFrame();
+    uint32_t stateChecksum(); // Hash of everything the simulation carries between ticks
+    void seedRandom(uint32_t seed); // begin() seeds from random(), so randomSeed() still works
+
+    // --- Save States ---
+    // saveState() copies everything the simulation carries between ticks
+    // into `out` (fixed size, no allocation); loadState() puts it back and
+    // publishes it for drawing. Particles are cosmetic and start empty after
+    // a load, and the high score stays the higher of the live and saved
+    // one. Play carries on from the load as if the clock had stopped there.
+    // loadState() returns false, changing nothing, for a state saved by
+    // another build, one that fails its CRC or range checks, or while
+    // recording or replaying. See SaveState.h for delta encoding.
+    void saveState(SaveState &out);
+    bool loadState(const SaveState &in);
+
+    // --- Profiling ---
+    // Timings of the last PROFILER_SAMPLES runs of each phase. Needs the
+    // library built with ASTRO_ENABLE_PROFILER; otherwise getProfile()
+    // returns false and dumpProfile() prints a note. While the render task
+    // runs, it hands over the raster and flush timings it records, so these
+    // wait up to one render frame for it.
+    bool getProfile(ProfilePhase phase, ProfileStats &stats);
+    void dumpProfile(Print &out); // One line per phase: count, min/mean/p99/max ns, histogram
+    void resetProfile();
+
+#if defined(ASTRO_HOST_BUILD)
+    friend class ScenarioBuilder; // extras/host/bench_scenarios.cpp: builds stress worlds in place
+    template <typename> friend class BatchSimulator; // extras/host/batch: steps games headless in lock-step
+#endif
+
 private:
+    typedef BasicDirtyRegion<Config::WIDTH, Config::HEIGHT> Region;
+    typedef typename RenderOnly<Config::RENDERING, Region>::type RenderRegion;
+    typedef typename RenderOnly<Config::RENDERING, HudText>::type RenderHudText;
+    typedef std::integral_constant<bool, Config::RENDERING> Rendering;
+
+    // stagedWrite: the sim side stages a record, the render side writes it
+    static const uint8_t STAGE_IDLE = 0;
+    static const uint8_t STAGE_PENDING = 1; // Render side to write
+    static const uint8_t STAGE_WRITTEN = 2; // Sim side to collect
+    static const uint8_t STAGE_FAILED = 3;
+
+    // profileHandoff: the sim side asks, the render side serves its phases
+    static const uint8_t HANDOFF_IDLE = 0;
+    static const uint8_t HANDOFF_FETCH = 1; // Render side to copy its stats out
+    static const uint8_t HANDOFF_RESET = 2; // Render side to clear its rings
+    static const uint8_t HANDOFF_DONE = 3;  // Sim side to collect
+
+    // HUD layout: panels under 64 rows get the menus squeezed into 32
+    static const bool COMPACT_HUD = Config::HEIGHT < 64;
+
     // Dependencies
     Adafruit_SSD1306 &display;
     AudioEngine audio;
     Preferences preferences;
+    Leaderboard leaderboard;
+    TimeSource timeSource;
+
+    typename RenderOnly<Config::RENDERING, BasicFrameRaster<Config::WIDTH, Config::HEIGHT> >::type raster; // Direct framebuffer drawing for game objects
+
+    // Partial Flush
+    TwoWire *flushWire; // NULL = full display() every frame
+    uint8_t flushAddress;
+    RenderRegion frameDirty;     // Drawn this frame
+    RenderRegion lastFrameDirty; // Drawn last frame (must be erased on the panel)
+    RenderHudText hudScoreText;  // Cached HUD glyph runs, rebuilt when the value changes
+    RenderHudText hudHighScoreText;
+    int hudLives;             // Lives last drawn
+
+    // Simulation -> render handoff
+    typename RenderOnly<Config::RENDERING, TripleBuffer<Snapshot> >::type snapshots;
+    uint32_t snapshotSequence;
+    GameState renderedState; // State of the last rendered snapshot (render side)
+    uint32_t sceneVersion;      // Bumped when a static screen's contents change (sim side)
+    GameState sceneState;       // What sceneVersion was last bumped for
+    int sceneScore, sceneHighScore;
+    uint32_t drawnSceneVersion; // Static screen on the panel, 0 = none (render side)
+    std::atomic<bool> renderRunning;
+    LeaderboardRecord stagedRecord; // Leaderboard write handed to the render side
+    uint8_t stagedSlot;
+    std::atomic<uint8_t> stagedWrite; // STAGE_* below
+#if defined(ESP32)
+    TaskHandle_t renderTaskHandle;
+    std::atomic<bool> renderStopped;
+#elif defined(ASTRO_HOST_BUILD)
+    std::thread renderThread;
+    std::mutex renderWakeLock;
+    std::condition_variable renderWake;
+    bool renderWakePending; // Guarded by renderWakeLock
+#endif
 
     // Hardware Pins
     int fireButtonPin;
@@ -38,50 +224,125 @@ private:
     // Game State
     GameState currentState;
     GameObject ship; // These use the definition from GameData.h
-    GameObject bullets[MAX_BULLETS];
-    GameObject asteroids[MAX_ASTEROIDS];
+    EntityPool<Config::MAX_BULLETS> bullets;
+    EntityPool<Config::MAX_ASTEROIDS> asteroids;
+    AsteroidMesh asteroidMeshes[Config::MAX_ASTEROIDS]; // Outline per asteroid pool slot
+    CollisionGrid<Config::MAX_ASTEROIDS, Config::WIDTH, Config::HEIGHT> asteroidGrid; // Rebuilt each handleCollisions()
+    ParticlePool<Config::PARTICLE_CAPACITY, Config::WIDTH, Config::HEIGHT> particles; // Debris and exhaust; cosmetic only
     int score;
     int lives;
     int highScore;
 
+    // Fixed Timestep
+    int tickRate;
+    Scalar tickScale;       // Reference frames per tick
+    Scalar tickFriction;    // SHIP_FRICTION compounded over one tick
+    BAngle tickTurnSpeed;
+    float tickThrust;
+    int bulletLifetimeTicks;
+    uint8_t debrisLifetimeTicks;
+    uint8_t exhaustLifetimeTicks;
+    unsigned long lastUpdateTime; // Real clock at the previous update()
+    uint32_t tickAccumulator;     // Unsimulated time, TICK_UNIT per tick
+    uint32_t tickCount;           // Ticks since simBaseTime
+    unsigned long simBaseTime;
+    bool fireLatched;             // Button seen down since the last tick
+    bool hyperspaceLatched;
+    Vector2D prevShipPos;         // Ship at the start of the current tick
+    BAngle prevShipAngle;
+
+    // Recording & Replay
+    FastRandom rng;             // Game randomness; never the global random()
+    FastRandom particleRng;     // Cosmetic randomness, so particles never shift the game's
+    InputLogWriter *recorder;   // NULL unless recording
+    InputLogReader *player;     // NULL unless replaying
+#if defined(ASTRO_ENABLE_PROFILER)
+    FrameProfiler profiler;  // Render phases are written by the render side once it runs
+    ProfileStats renderStats[PROFILE_PHASE_COUNT - PROFILE_RASTER]; // As last handed over
+    std::atomic<uint8_t> profileHandoff; // HANDOFF_* above
+#endif
+
     // Input & Timing State
     bool fireButtonPressedLastFrame;
     bool hyperspaceButtonPressedLastFrame;
     unsigned long lastFireTime;
     unsigned long shipSpawnTime;
     unsigned long lastHyperspaceTime;
+    unsigned long waveClearTime; // When the WAVE_CLEAR pause started
     bool isThrusting;
 
     // --- Private Helper Methods ---
     // Core Logic
+    void advance(const InputFrame &frame);
+    void stepSimulation(int joyX, int joyY, bool anyFireButtonDown, bool digitalHyperspaceDown);
+    void beginTick();
+    void snapShipPose();
     void resetGame();
     // UPDATED DECLARATION TO MATCH DEFINITION
     void handleInput(int joyX, int joyY, bool anyFireButtonDown, bool digitalHyperspaceDown);
     void updateGameObjects();
     void handleCollisions();
     bool checkLevelClear();
+    void beginWaveClear();
     void spawnNewWave();
     void triggerHyperspace();
 
     // Object Management & Drawing
-    void spawnAsteroid(int size, float x = -1, float y = -1, float initial_vx = 0, float initial_vy = 0);
-    int findInactiveBulletSlot();
-    int findInactiveAsteroidSlot();
-    void wrapAround(GameObject &obj);
-    void drawShip(bool invincible);
-    void drawAsteroids();
-    void drawBullets();
-    void drawUI();
+    void spawnAsteroid(int size, Scalar x = -1, Scalar y = -1, Scalar initial_vx = 0, Scalar initial_vy = 0);
+    void buildAsteroidMesh(AsteroidMesh &mesh, int size);
+    void spawnDebris(Scalar x, Scalar y, Scalar vx, Scalar vy, int count);
+    void spawnExhaust(Scalar headingSin, Scalar headingCos);
+    void wrapAround(Scalar &x, Scalar &y);
+    void drawShip(const Snapshot &snap, bool invincible);
+    void drawAsteroids(const Snapshot &snap);
+    void drawBullets(const Snapshot &snap);
+    void drawParticles(const Snapshot &snap);
+    void drawUI(const Snapshot &snap);
     void drawStartMenu();
-    void drawGameOverScreen();
+    void drawGameOverScreen(const Snapshot &snap);
+    void drawWaveClear();
+    void flushDisplay();
+
+    // Pipelined Rendering
+    void publishSnapshot() { publishSnapshot(Rendering()); }
+    void publishSnapshot(std::true_type);
+    void publishSnapshot(std::false_type) {} // Headless: no render side to hand to
+    void renderSnapshot(const Snapshot &snap);
+    void rasterSnapshot(const Snapshot &snap);
+    void renderLoop();
+    void wakeRenderTask();
+    void syncRenderProfile(uint8_t request);
+    void serveRenderProfile(uint8_t request);
+#if defined(ESP32)
+    static void renderTaskEntry(void *arg);
+#endif
 
     // Utility
-    void rotatePoint(float cx, float cy, float angle, float &x, float &y);
+    unsigned long currentMillis();
+    unsigned long simMillis(); // Simulation clock: advances one tick at a time
+    void restartSession(const InputLogHeader &header);
+    void resetSimulation(const InputLogHeader &header); // restartSession() minus the clock and snapshot
+    void rotatePoint(float sinA, float cosA, float &x, float &y);
 
     // NVS Helpers
     void loadHighScore();
-    void saveHighScore();
+    void recordScore(int finalScore);
+    void commitLeaderboard(unsigned long now);
+    void collectLeaderboardWrite(unsigned long now);
+    void settleLeaderboardWrite();
+    void writeStagedLeaderboard();
 
+    // Snapshot counts are 16-bit
+    static_assert(Config::MAX_BULLETS <= 65535 && Config::MAX_ASTEROIDS <= 65535 && Config::PARTICLE_CAPACITY <= 65535,
+                  "Pool capacities must fit the snapshot counts");
+    static_assert(Config::STARTING_ASTEROIDS <= Config::MAX_ASTEROIDS, "First wave must fit the asteroid pool");
 };
 
+typedef BasicAstroLib<DefaultConfig> AstroLib;
+
+#include "AstroLibImpl.h"
+
+// The default build is compiled once, in AstroLib.cpp
+extern template class BasicAstroLib<DefaultConfig>;
+
 #endif // ASTRO_LIB_H
\ No newline at end of file
@@ -0,0 +1,1732 @@
+#ifndef ASTRO_LIB_IMPL_H
+#define ASTRO_LIB_IMPL_H
+
+// AstroLibImpl.h - BasicAstroLib member definitions. Included by AstroLib.h
+// only; every Config instantiates the same code.
+
+// --- Preferences Namespace ---
+// Use a unique namespace for your application's preferences
+// to avoid collisions with other libraries/sketches.
+const char *const PREFERENCES_NAMESPACE = "AstroLib";
+const char *const PREF_KEY_HIGH_SCORE = "highScore";
+
+// --- Constructor ---
+template <typename Config>
+BasicAstroLib<Config>::BasicAstroLib(Adafruit_SSD1306 &disp) : display(disp), audio(), preferences(), // Initialize Preferences object
+                                             timeSource(millis), flushWire(NULL), flushAddress(0),
+                                             hudScoreText(""), hudHighScoreText("HI:"), hudLives(-1),
+                                             snapshotSequence(0), renderedState(START), sceneVersion(1), sceneState(START),
+                                             sceneScore(0), sceneHighScore(0), drawnSceneVersion(0), renderRunning(false),
+                                             stagedSlot(0), stagedWrite(STAGE_IDLE),
+                                             fireButtonPin(-1), hyperspaceButtonPin(-1),
+                                             currentState(START), score(0), lives(3), highScore(0), // Init highScore to 0 initially
+                                             tickAccumulator(0), tickCount(0), simBaseTime(0),
+                                             fireLatched(false), hyperspaceLatched(false),
+                                             rng(1), particleRng(2), recorder(NULL), player(NULL),
+                                             fireButtonPressedLastFrame(false), hyperspaceButtonPressedLastFrame(false),
+                                             lastFireTime(0), shipSpawnTime(0), lastHyperspaceTime(0), waveClearTime(0),
+                                             isThrusting(false)
+{
+#if defined(ESP32)
+    renderTaskHandle = NULL; // Before publishSnapshot(), which notifies the task if there is one
+    renderStopped = true;
+#elif defined(ASTRO_HOST_BUILD)
+    renderWakePending = false;
+#endif
+#if defined(ASTRO_ENABLE_PROFILER)
+    memset(renderStats, 0, sizeof(renderStats));
+    profileHandoff = HANDOFF_IDLE;
+#endif
+    ship.active = false;
+    prevShipPos.x = prevShipPos.y = 0;
+    prevShipAngle = 0;
+    setTickRate(SIM_TICK_RATE);
+    particles.setBudget(Config::PARTICLE_BUDGET);
+    lastUpdateTime = currentMillis();
+    lastFrameDirty.markAll(); // Panel contents unknown until the first flush
+    publishSnapshot();        // draw() before the first update() still has a frame
+}
+
+template <typename Config>
+BasicAstroLib<Config>::~BasicAstroLib()
+{
+    stopRenderTask();
+}
+
+// --- Public Method Implementations ---
+
+template <typename Config>
+void BasicAstroLib<Config>::begin(int audioPin)
+{
+    // Initialize pools
+    bullets.clear();
+    asteroids.clear();
+
+    // Initialize Preferences - MUST be done before accessing NVS
+    // The 'false' parameter indicates read/write mode.
+    preferences.begin(PREFERENCES_NAMESPACE, false);
+
+    // Load the high score from NVS AFTER beginning preferences
+    loadHighScore();
+
+    seedRandom((uint32_t)random(0x7FFFFFFF)); // Follows the sketch's randomSeed()
+    resetGame(); // Sets up initial game state (doesn't reset loaded high score)
+    currentState = START;
+    lastUpdateTime = currentMillis(); // Ticks start counting from here
+    tickAccumulator = 0;
+
+    audio.begin(audioPin);
+
+    Serial.print("Astrolib Initialized. Loaded High Score: ");
+    Serial.println(highScore);
+}
+
+// --- Configuration ---
+template <typename Config>
+void BasicAstroLib<Config>::attachFireButtonPin(int pin)
+{ // Renamed
+    fireButtonPin = pin;
+    if (fireButtonPin >= 0)
+    {
+        pinMode(fireButtonPin, INPUT_PULLUP);
+    }
+}
+
+template <typename Config>
+void BasicAstroLib<Config>::attachHyperspaceButtonPin(int pin)
+{ // Renamed
+    hyperspaceButtonPin = pin;
+    if (hyperspaceButtonPin >= 0)
+    {
+        pinMode(hyperspaceButtonPin, INPUT_PULLUP);
+    }
+}
+
+template <typename Config>
+void BasicAstroLib<Config>::attachTimeSource(TimeSource source)
+{
+    timeSource = source ? source : millis;
+    audio.attachTimeSource(timeSource); // Keep sound timing on the same clock
+    lastUpdateTime = currentMillis();   // Don't count the jump between clocks
+}
+
+template <typename Config>
+void BasicAstroLib<Config>::setTickRate(int ticksPerSecond)
+{
+    if (ticksPerSecond <= 0)
+        ticksPerSecond = SIM_TICK_RATE;
+    simBaseTime = (tickCount > 0) ? simMillis() : simBaseTime; // Keep the sim clock continuous
+    tickCount = 0;
+    tickAccumulator = 0;
+    tickRate = ticksPerSecond;
+
+    float scale = (float)SIM_REFERENCE_RATE / tickRate;
+    tickScale = scale;
+    tickFriction = powf(toFloat(SHIP_FRICTION), scale);
+    tickTurnSpeed = (BAngle)(SHIP_TURN_SPEED * scale);
+    tickThrust = SHIP_THRUST * scale;
+    bulletLifetimeTicks = max(1, (int)(Config::BULLET_LIFETIME / scale + 0.5f));
+    debrisLifetimeTicks = (uint8_t)min(255, max(2, (int)(DEBRIS_LIFETIME * tickRate / 1000)));
+    exhaustLifetimeTicks = (uint8_t)min(255, max(1, (int)(EXHAUST_LIFETIME * tickRate / 1000)));
+}
+
+template <typename Config>
+void BasicAstroLib<Config>::setParticleBudget(int perTick)
+{
+    particles.setBudget(perTick);
+}
+
+template <typename Config>
+bool BasicAstroLib<Config>::attachPartialFlush(TwoWire &wire, uint8_t i2cAddress)
+{
+    if (renderRunning)
+        return false; // The render side owns the panel state now
+    flushWire = &wire;
+    flushAddress = i2cAddress;
+    lastFrameDirty.markAll(); // Next flush resyncs the whole panel
+    drawnSceneVersion = 0;    // Even on a static screen
+    return true;
+}
+
+template <typename Config>
+void BasicAstroLib<Config>::attachSynth(PcmSynth &synth)
+{
+    audio.attachSynth(synth);
+}
+
+template <typename Config>
+GameState BasicAstroLib<Config>::getCurrentState() { return currentState; }
+template <typename Config>
+int BasicAstroLib<Config>::getScore() { return score; }
+template <typename Config>
+int BasicAstroLib<Config>::getHighScore() { return highScore; }
+template <typename Config>
+void BasicAstroLib<Config>::resetHighScore()
+{
+    highScore = 0;
+    if (!player)
+        leaderboard.clear(currentMillis());
+}
+
+template <typename Config>
+int BasicAstroLib<Config>::getLeaderboardCount() { return leaderboard.count(); }
+template <typename Config>
+int BasicAstroLib<Config>::getLeaderboardScore(int rank) { return leaderboard.score(rank); }
+template <typename Config>
+void BasicAstroLib<Config>::flushLeaderboard()
+{
+    settleLeaderboardWrite();
+    leaderboard.commit(currentMillis());
+}
+
+template <typename Config>
+void BasicAstroLib<Config>::update(int joyX, int joyY, bool joyButtonDown)
+{
+    // --- Read Digital Buttons ---
+    bool digitalFireDown = (fireButtonPin >= 0) && (digitalRead(fireButtonPin) == LOW);
+    bool digitalHyperspaceDown = (hyperspaceButtonPin >= 0) && (digitalRead(hyperspaceButtonPin) == LOW);
+
+    // --- Frame Timing ---
+    unsigned long now = currentMillis();
+    unsigned long elapsed = now - lastUpdateTime;
+    lastUpdateTime = now;
+    unsigned long maxElapsed = (unsigned long)MAX_TICKS_PER_UPDATE * TICK_UNIT / tickRate + 1;
+
+    // Everything the simulation sees this update; a replay feeds back the same
+    InputFrame frame;
+    frame.elapsedMs = (uint16_t)min(elapsed, maxElapsed); // Bounded: no overflow after a long stall
+    frame.joyX = (int16_t)joyX;
+    frame.joyY = (int16_t)joyY;
+    frame.fire = joyButtonDown || digitalFireDown;
+    frame.hyperspace = digitalHyperspaceDown;
+    if (recorder)
+        recorder->append(frame);
+    advance(frame);
+
+    commitLeaderboard(now);
+}
+
+// Runs the fixed ticks one update() has covered. Depends only on `frame`
+// and the simulation state, never on the clock or the pins.
+template <typename Config>
+void BasicAstroLib<Config>::advance(const InputFrame &frame)
+{
+    ASTRO_PROFILE(profiler, PROFILE_UPDATE);
+    int joyX = frame.joyX, joyY = frame.joyY;
+    bool anyFireButtonDown = frame.fire;
+    bool digitalHyperspaceDown = frame.hyperspace;
+
+    // A tap that starts and ends between two ticks still reaches the next one
+    fireLatched = fireLatched || anyFireButtonDown;
+    hyperspaceLatched = hyperspaceLatched || digitalHyperspaceDown;
+
+    // --- Fixed Timestep ---
+    tickAccumulator += (uint32_t)frame.elapsedMs * tickRate;
+
+    int ticks = 0;
+    while (tickAccumulator >= (uint32_t)TICK_UNIT)
+    {
+        if (ticks == MAX_TICKS_PER_UPDATE)
+        {
+            tickAccumulator %= TICK_UNIT; // Too far behind: drop time rather than stall
+            break;
+        }
+        tickCount++;
+        stepSimulation(joyX, joyY, fireLatched, hyperspaceLatched);
+        fireLatched = anyFireButtonDown; // Later ticks this update see the live level
+        hyperspaceLatched = digitalHyperspaceDown;
+        tickAccumulator -= TICK_UNIT;
+        ticks++;
+    }
+    if (ticks > 0)
+    {
+        fireLatched = false;
+        hyperspaceLatched = false;
+    }
+
+    audio.update();
+    publishSnapshot();
+}
+
+template <typename Config>
+void BasicAstroLib<Config>::stepSimulation(int joyX, int joyY, bool anyFireButtonDown, bool digitalHyperspaceDown) {
+    // --- State Transitions & Logic ---
+    switch (currentState) {
+        // ... (case START remains the same) ...
+         case START:
+            if (anyFireButtonDown && !fireButtonPressedLastFrame) {
+                resetGame();
+                currentState = GAME;
+                fireButtonPressedLastFrame = true;
+                hyperspaceButtonPressedLastFrame = true;
+                return;
+            }
+            break;
+
+        case GAME:
+            beginTick();
+            {
+                ASTRO_PROFILE(profiler, PROFILE_INPUT);
+                handleInput(joyX, joyY, anyFireButtonDown, digitalHyperspaceDown);
+            }
+            {
+                ASTRO_PROFILE(profiler, PROFILE_PHYSICS);
+                updateGameObjects();
+            }
+            {
+                ASTRO_PROFILE(profiler, PROFILE_COLLISIONS);
+                handleCollisions();
+            }
+
+            if (lives <= 0 && !ship.active) {
+                // --- Game Over Transition ---
+                currentState = GAME_OVER;
+                // Update High Score if needed; the leaderboard reaches NVS later
+                if (score > highScore) {
+                    Serial.print("New High Score! "); Serial.println(score);
+                    highScore = score;
+                }
+                recordScore(score);
+                fireButtonPressedLastFrame = true;
+                hyperspaceButtonPressedLastFrame = true;
+                audio.stopAllSounds();
+                return;
+            }
+            // ... (checkLevelClear remains the same) ...
+            else if (checkLevelClear() && lives > 0) {
+                 beginWaveClear();
+            }
+            break;
+
+        case WAVE_CLEAR:
+            // Timed pause instead of blocking: audio and input keep running
+            if (simMillis() - waveClearTime >= WAVE_CLEAR_DURATION) {
+                spawnNewWave();
+                currentState = GAME;
+            }
+            break;
+
+        // ... (case GAME_OVER remains the same) ...
+         case GAME_OVER:
+             if (anyFireButtonDown && !fireButtonPressedLastFrame) {
+                 currentState = START;
+                 fireButtonPressedLastFrame = true;
+                 hyperspaceButtonPressedLastFrame = true;
+                 return;
+             }
+             break;
+    }
+
+    fireButtonPressedLastFrame = anyFireButtonDown;
+    hyperspaceButtonPressedLastFrame = digitalHyperspaceDown;
+}
+
+// The ship was placed, not moved (new game, respawn, hyperspace): frames
+// until the next tick show it where it is instead of sliding it there
+template <typename Config>
+void BasicAstroLib<Config>::snapShipPose()
+{
+    prevShipPos = ship.pos;
+    prevShipAngle = ship.angle;
+}
+
+// Remembers where everything starts this tick, for render interpolation
+template <typename Config>
+void BasicAstroLib<Config>::beginTick()
+{
+    prevShipPos = ship.pos;
+    prevShipAngle = ship.angle;
+    for (int i = bullets.first(); i >= 0; i = bullets.next(i))
+    {
+        bullets.prevX[i] = bullets.posX[i];
+        bullets.prevY[i] = bullets.posY[i];
+    }
+    for (int i = asteroids.first(); i >= 0; i = asteroids.next(i))
+    {
+        asteroids.prevX[i] = asteroids.posX[i];
+        asteroids.prevY[i] = asteroids.posY[i];
+    }
+}
+
+template <typename Config>
+void BasicAstroLib<Config>::draw()
+{ // Renamed
+    if (renderRunning)
+        return; // The render task draws
+    snapshots.acquire(); // Nothing new: redraw the last frame
+    renderSnapshot(snapshots.readSlot());
+}
+
+// --- Pipelined Rendering ---
+
+template <typename Config>
+bool BasicAstroLib<Config>::startRenderTask(int core)
+{
+    if (renderRunning)
+        return true;
+#if defined(ESP32)
+    renderRunning = true;
+    renderStopped = false;
+    if (xTaskCreatePinnedToCore(renderTaskEntry, "astro_render", RENDER_TASK_STACK, this, 1,
+                                &renderTaskHandle, core) != pdPASS)
+    {
+        renderRunning = false;
+        renderTaskHandle = NULL;
+        return false;
+    }
+    return true;
+#elif defined(ASTRO_HOST_BUILD)
+    (void)core; // Host threads are not pinned
+    renderRunning = true;
+    renderThread = std::thread(&BasicAstroLib::renderLoop, this);
+    return true;
+#else
+    (void)core;
+    return false; // No second core: keep calling draw()
+#endif
+}
+
+template <typename Config>
+void BasicAstroLib<Config>::stopRenderTask()
+{
+    if (!renderRunning)
+        return;
+    renderRunning = false;
+    wakeRenderTask();
+#if defined(ESP32)
+    while (!renderStopped)
+        delay(1);
+    renderTaskHandle = NULL;
+#elif defined(ASTRO_HOST_BUILD)
+    renderThread.join();
+#endif
+    settleLeaderboardWrite();
+}
+
+template <typename Config>
+bool BasicAstroLib<Config>::isPipelined() { return renderRunning; }
+
+// --- Recording & Replay ---
+
+template <typename Config>
+void BasicAstroLib<Config>::startRecording(InputLogWriter &log, uint32_t seed)
+{
+    InputLogHeader header = {seed, (uint16_t)tickRate, highScore};
+    player = NULL;
+    restartSession(header);
+    log.begin(header);
+    recorder = &log;
+}
+
+template <typename Config>
+void BasicAstroLib<Config>::stopRecording()
+{
+    if (!recorder)
+        return;
+    recorder->finish(stateChecksum());
+    recorder = NULL;
+}
+
+template <typename Config>
+bool BasicAstroLib<Config>::startReplay(InputLogReader &log)
+{
+    InputLogHeader header;
+    if (!log.readHeader(header))
+        return false;
+    stopRecording();
+    restartSession(header);
+    player = &log;
+    return true;
+}
+
+template <typename Config>
+bool BasicAstroLib<Config>::replayFrame()
+{
+    InputFrame frame;
+    if (!player || !player->next(frame))
+    {
+        player = NULL;
+        return false;
+    }
+    advance(frame);
+    return true;
+}
+
+// Puts every piece of simulation state into a known starting point, so a
+// recording and its replay start from identical games.
+template <typename Config>
+void BasicAstroLib<Config>::restartSession(const InputLogHeader &header)
+{
+    resetSimulation(header);
+    lastUpdateTime = currentMillis();
+    publishSnapshot();
+}
+
+template <typename Config>
+void BasicAstroLib<Config>::resetSimulation(const InputLogHeader &header)
+{
+    setTickRate(header.tickRate);
+    simBaseTime = 0;
+    seedRandom(header.seed);
+    highScore = header.highScore;
+    fireLatched = false;
+    hyperspaceLatched = false;
+    lastFireTime = 0;
+    waveClearTime = 0;
+    resetGame();
+    currentState = START;
+}
+
+template <typename Config>
+void BasicAstroLib<Config>::seedRandom(uint32_t seed)
+{
+    rng.seed(seed);
+    particleRng.seed(seed ^ 0x9E3779B9u);
+}
+
+// --- Save States ---
+
+template <typename Config>
+void BasicAstroLib<Config>::saveState(SaveState &out)
+{
+    out.magic = SAVE_STATE_MAGIC;
+    out.version = SAVE_STATE_VERSION;
+    out.layout = SaveState::layoutId();
+    out.state = (uint8_t)currentState;
+    out.flags = (ship.active ? SAVE_SHIP_ACTIVE : 0) | (fireLatched ? SAVE_FIRE_LATCHED : 0) |
+                (hyperspaceLatched ? SAVE_HYPERSPACE_LATCHED : 0) | (fireButtonPressedLastFrame ? SAVE_FIRE_HELD : 0) |
+                (hyperspaceButtonPressedLastFrame ? SAVE_HYPERSPACE_HELD : 0);
+
+    out.simBaseTime = (uint32_t)simBaseTime;
+    out.lastFireTime = (uint32_t)lastFireTime;
+    out.shipSpawnTime = (uint32_t)shipSpawnTime;
+    out.lastHyperspaceTime = (uint32_t)lastHyperspaceTime;
+    out.waveClearTime = (uint32_t)waveClearTime;
+
+    out.tickCount = tickCount;
+    out.tickAccumulator = tickAccumulator;
+    out.score = score;
+    out.lives = lives;
+    out.highScore = highScore;
+    out.shipLifetime = ship.lifetime;
+    out.tickRate = (uint16_t)tickRate;
+    out.shipAngle = ship.angle;
+    out.prevShipAngle = prevShipAngle;
+
+    out.shipX = ship.pos.x;
+    out.shipY = ship.pos.y;
+    out.shipVelX = ship.vel.x;
+    out.shipVelY = ship.vel.y;
+    out.prevShipX = prevShipPos.x;
+    out.prevShipY = prevShipPos.y;
+    out.shipRadius = ship.radius;
+
+    out.rng = rng;
+    out.particleRng = particleRng;
+    out.bullets = bullets;
+    out.asteroids = asteroids;
+    memcpy(out.asteroidMeshes, asteroidMeshes, sizeof(asteroidMeshes));
+    // Free slots and unused vertices hold whatever the last object (or
+    // nothing) left behind; zeroed, the same game always saves to the same
+    // bytes
+    out.bullets.zeroFree();
+    out.asteroids.zeroFree();
+    for (int i = 0; i < Config::MAX_ASTEROIDS; ++i)
+    {
+        AsteroidMesh &mesh = out.asteroidMeshes[i];
+        if (!asteroids.isActive(i))
+            mesh.vertexCount = 0;
+        for (int v = mesh.vertexCount; v < MAX_ASTEROID_VERTICES; ++v)
+            mesh.dx[v] = mesh.dy[v] = 0;
+    }
+    out.seal();
+}
+
+template <typename Config>
+bool BasicAstroLib<Config>::loadState(const SaveState &in)
+{
+    if (!in.valid() || recorder || player)
+        return false; // Nothing changed yet
+
+    if (in.tickRate != tickRate)
+        setTickRate(in.tickRate); // Per-tick constants; the clock fields are overwritten below
+    currentState = (GameState)in.state;
+    ship.active = (in.flags & SAVE_SHIP_ACTIVE) != 0;
+    fireLatched = (in.flags & SAVE_FIRE_LATCHED) != 0;
+    hyperspaceLatched = (in.flags & SAVE_HYPERSPACE_LATCHED) != 0;
+    fireButtonPressedLastFrame = (in.flags & SAVE_FIRE_HELD) != 0;
+    hyperspaceButtonPressedLastFrame = (in.flags & SAVE_HYPERSPACE_HELD) != 0;
+
+    simBaseTime = in.simBaseTime;
+    lastFireTime = in.lastFireTime;
+    shipSpawnTime = in.shipSpawnTime;
+    lastHyperspaceTime = in.lastHyperspaceTime;
+    waveClearTime = in.waveClearTime;
+
+    tickCount = in.tickCount;
+    tickAccumulator = in.tickAccumulator;
+    score = in.score;
+    lives = in.lives;
+    highScore = max(highScore, (int)in.highScore); // An old state never lowers the best score
+    ship.lifetime = in.shipLifetime;
+    ship.angle = in.shipAngle;
+    prevShipAngle = in.prevShipAngle;
+
+    ship.pos.x = in.shipX;
+    ship.pos.y = in.shipY;
+    ship.vel.x = in.shipVelX;
+    ship.vel.y = in.shipVelY;
+    prevShipPos.x = in.prevShipX;
+    prevShipPos.y = in.prevShipY;
+    ship.radius = in.shipRadius;
+
+    rng = in.rng;
+    particleRng = in.particleRng;
+    bullets = in.bullets;
+    asteroids = in.asteroids;
+    memcpy(asteroidMeshes, in.asteroidMeshes, sizeof(asteroidMeshes));
+
+    particles.clear();
+    isThrusting = false; // Re-evaluated from the stick on the next tick
+    audio.stopAllSounds();
+    lastUpdateTime = currentMillis();
+    publishSnapshot();
+    return true;
+}
+
+// FNV-1a over a value's bytes. Only fields are fed in, never whole structs,
+// so padding cannot make two identical games hash differently.
+template <typename T>
+inline uint32_t hashValue(uint32_t h, const T &value)
+{
+    uint8_t bytes[sizeof(T)];
+    memcpy(bytes, &value, sizeof(T));
+    for (size_t i = 0; i < sizeof(T); ++i)
+        h = (h ^ bytes[i]) * 16777619u;
+    return h;
+}
+
+template <typename Config>
+uint32_t BasicAstroLib<Config>::stateChecksum()
+{
+    uint32_t h = 2166136261u;
+    h = hashValue(h, (int)currentState);
+    h = hashValue(h, score);
+    h = hashValue(h, lives);
+    h = hashValue(h, highScore);
+    h = hashValue(h, tickCount);
+    h = hashValue(h, tickAccumulator);
+    h = hashValue(h, rng);
+    h = hashValue(h, ship.pos.x);
+    h = hashValue(h, ship.pos.y);
+    h = hashValue(h, ship.vel.x);
+    h = hashValue(h, ship.vel.y);
+    h = hashValue(h, ship.angle);
+    h = hashValue(h, ship.lifetime);
+    h = hashValue(h, ship.active);
+    h = hashValue(h, lastFireTime);
+    h = hashValue(h, shipSpawnTime);
+    h = hashValue(h, lastHyperspaceTime);
+    h = hashValue(h, waveClearTime);
+    for (int i = bullets.first(); i >= 0; i = bullets.next(i))
+    {
+        h = hashValue(h, i);
+        h = hashValue(h, bullets.posX[i]);
+        h = hashValue(h, bullets.posY[i]);
+        h = hashValue(h, bullets.velX[i]);
+        h = hashValue(h, bullets.velY[i]);
+        h = hashValue(h, bullets.lifetime[i]);
+    }
+    for (int i = asteroids.first(); i >= 0; i = asteroids.next(i))
+    {
+        h = hashValue(h, i);
+        h = hashValue(h, asteroids.posX[i]);
+        h = hashValue(h, asteroids.posY[i]);
+        h = hashValue(h, asteroids.velX[i]);
+        h = hashValue(h, asteroids.velY[i]);
+        h = hashValue(h, asteroids.size[i]);
+    }
+    return h;
+}
+
+// --- Profiling ---
+
+template <typename Config>
+bool BasicAstroLib<Config>::getProfile(ProfilePhase phase, ProfileStats &stats)
+{
+#if defined(ASTRO_ENABLE_PROFILER)
+    if (phase < 0 || phase >= PROFILE_PHASE_COUNT)
+        return false;
+    if (phase < PROFILE_RASTER)
+    {
+        profiler.stats(phase, stats);
+        return true;
+    }
+    syncRenderProfile(HANDOFF_FETCH);
+    stats = renderStats[phase - PROFILE_RASTER];
+    return true;
+#else
+    (void)phase;
+    memset(&stats, 0, sizeof(stats));
+    return false;
+#endif
+}
+
+// e.g. "raster n=256 min=4210 mean=4630 p99=7120 max=8050 ns h=0,0,0,0,0,11,240,5,..."
+template <typename Config>
+void BasicAstroLib<Config>::dumpProfile(Print &out)
+{
+#if defined(ASTRO_ENABLE_PROFILER)
+    char line[160];
+    for (int p = 0; p < PROFILE_PHASE_COUNT; ++p)
+    {
+        ProfileStats stats;
+        getProfile((ProfilePhase)p, stats);
+        int len = snprintf(line, sizeof(line), "%s n=%u min=%lu mean=%lu p99=%lu max=%lu ns h=",
+                           profilePhaseName((ProfilePhase)p), (unsigned)stats.samples, (unsigned long)stats.minNs,
+                           (unsigned long)stats.meanNs, (unsigned long)stats.p99Ns, (unsigned long)stats.maxNs);
+        for (int b = 0; b < PROFILER_HISTOGRAM_BUCKETS && len < (int)sizeof(line); ++b)
+            len += snprintf(line + len, sizeof(line) - len, b ? ",%u" : "%u", (unsigned)stats.histogram[b]);
+        out.println(line);
+    }
+#else
+    out.println("profiler not built (define ASTRO_ENABLE_PROFILER)");
+#endif
+}
+
+template <typename Config>
+void BasicAstroLib<Config>::resetProfile()
+{
+#if defined(ASTRO_ENABLE_PROFILER)
+    for (int p = 0; p < PROFILE_RASTER; ++p)
+        profiler.reset((ProfilePhase)p);
+    syncRenderProfile(HANDOFF_RESET);
+#endif
+}
+
+// Sim side: has the render side serve a request on the rings it writes, or
+// serves it here when there is no render task
+template <typename Config>
+void BasicAstroLib<Config>::syncRenderProfile(uint8_t request)
+{
+#if defined(ASTRO_ENABLE_PROFILER)
+    if (!renderRunning)
+    {
+        serveRenderProfile(request);
+        return;
+    }
+    profileHandoff.store(request, std::memory_order_release);
+    wakeRenderTask();
+    while (profileHandoff.load(std::memory_order_acquire) != HANDOFF_DONE)
+    {
+#if defined(ESP32)
+        delay(1);
+#elif defined(ASTRO_HOST_BUILD)
+        std::this_thread::yield();
+#endif
+    }
+    profileHandoff.store(HANDOFF_IDLE, std::memory_order_relaxed);
+#else
+    (void)request;
+#endif
+}
+
+// Render side (or the sim side when there is no render task)
+template <typename Config>
+void BasicAstroLib<Config>::serveRenderProfile(uint8_t request)
+{
+#if defined(ASTRO_ENABLE_PROFILER)
+    for (int p = PROFILE_RASTER; p < PROFILE_PHASE_COUNT; ++p)
+    {
+        if (request == HANDOFF_FETCH)
+            profiler.stats((ProfilePhase)p, renderStats[p - PROFILE_RASTER]);
+        else
+            profiler.reset((ProfilePhase)p);
+    }
+#else
+    (void)request;
+#endif
+}
+
+#if defined(ESP32)
+template <typename Config>
+void BasicAstroLib<Config>::renderTaskEntry(void *arg)
+{
+    BasicAstroLib *game = static_cast<BasicAstroLib *>(arg);
+    game->renderLoop();
+    game->renderStopped = true;
+    vTaskDelete(NULL);
+}
+#endif
+
+template <typename Config>
+void BasicAstroLib<Config>::renderLoop()
+{
+    while (renderRunning)
+    {
+        if (stagedWrite.load(std::memory_order_acquire) == STAGE_PENDING)
+            writeStagedLeaderboard();
+#if defined(ASTRO_ENABLE_PROFILER)
+        uint8_t request = profileHandoff.load(std::memory_order_acquire);
+        if (request == HANDOFF_FETCH || request == HANDOFF_RESET)
+        {
+            serveRenderProfile(request);
+            profileHandoff.store(HANDOFF_DONE, std::memory_order_release);
+        }
+#endif
+        if (snapshots.acquire())
+        {
+            renderSnapshot(snapshots.readSlot());
+            continue;
+        }
+        // Woken by publishSnapshot(), a staged write, a profile request or stopRenderTask()
+#if defined(ESP32)
+        ulTaskNotifyTake(pdTRUE, pdMS_TO_TICKS(100));
+#elif defined(ASTRO_HOST_BUILD)
+        std::unique_lock<std::mutex> lock(renderWakeLock);
+        renderWake.wait_for(lock, std::chrono::milliseconds(100), [this] { return renderWakePending; });
+        renderWakePending = false;
+#endif
+    }
+}
+
+// Counts like a task notification: a wake sent while the render side is
+// busy is still pending when it next waits
+template <typename Config>
+void BasicAstroLib<Config>::wakeRenderTask()
+{
+#if defined(ESP32)
+    if (renderTaskHandle)
+        xTaskNotifyGive(renderTaskHandle);
+#elif defined(ASTRO_HOST_BUILD)
+    {
+        std::lock_guard<std::mutex> lock(renderWakeLock);
+        renderWakePending = true;
+    }
+    renderWake.notify_one();
+#endif
+}
+
+// Blends a coordinate from its start-of-tick value towards the current one,
+// the short way round the wrapping axis. Teleports (respawn, hyperspace) are
+// not blended.
+inline Scalar interpolateWrapped(Scalar prev, Scalar cur, Scalar alpha, int period)
+{
+    Scalar d = toroidalDelta(cur - prev, period);
+    if (d > INTERP_SNAP_DISTANCE || d < -INTERP_SNAP_DISTANCE)
+        return cur;
+    return prev + d * alpha;
+}
+
+// Copies what rendering needs out of the live game state and hands it to
+// the render side. Runs at the end of every update(). Positions are blended
+// between the last two ticks by how far real time has got into the next one.
+template <typename Config>
+void BasicAstroLib<Config>::publishSnapshot(std::true_type)
+{
+    Scalar alpha = (float)tickAccumulator / TICK_UNIT;
+    Snapshot &snap = snapshots.writeSlot();
+    snap.sequence = ++snapshotSequence;
+    // The menu and game-over screens show nothing but the state and the scores
+    if (currentState != sceneState || score != sceneScore || highScore != sceneHighScore ||
+        (currentState != START && currentState != GAME_OVER))
+    {
+        sceneVersion++;
+        sceneState = currentState;
+        sceneScore = score;
+        sceneHighScore = highScore;
+    }
+    snap.sceneVersion = sceneVersion;
+    snap.state = currentState;
+    snap.time = simMillis();
+    snap.ship = ship;
+    snap.thrusting = isThrusting;
+    snap.score = score;
+    snap.highScore = highScore;
+    snap.lives = lives;
+    snap.ship.pos.x = interpolateWrapped(prevShipPos.x, ship.pos.x, alpha, Config::WIDTH);
+    snap.ship.pos.y = interpolateWrapped(prevShipPos.y, ship.pos.y, alpha, Config::HEIGHT);
+    snap.ship.angle = prevShipAngle + (BAngle)(int)((int16_t)(ship.angle - prevShipAngle) * toFloat(alpha));
+
+    int n = 0;
+    for (int i = bullets.first(); i >= 0; i = bullets.next(i), ++n)
+    {
+        snap.bulletX[n] = roundToInt(interpolateWrapped(bullets.prevX[i], bullets.posX[i], alpha, Config::WIDTH));
+        snap.bulletY[n] = roundToInt(interpolateWrapped(bullets.prevY[i], bullets.posY[i], alpha, Config::HEIGHT));
+    }
+    snap.bulletCount = n;
+
+    n = 0;
+    for (int i = asteroids.first(); i >= 0; i = asteroids.next(i), ++n)
+    {
+        snap.asteroidX[n] = roundToInt(interpolateWrapped(asteroids.prevX[i], asteroids.posX[i], alpha, Config::WIDTH));
+        snap.asteroidY[n] = roundToInt(interpolateWrapped(asteroids.prevY[i], asteroids.posY[i], alpha, Config::HEIGHT));
+        snap.asteroidSize[n] = asteroids.size[i];
+        snap.asteroidMesh[n] = asteroidMeshes[i];
+    }
+    snap.asteroidCount = n;
+
+    n = 0;
+    for (uint32_t k = particles.windowStart(); k != particles.windowEnd(); ++k)
+    {
+        int i = particles.slot(k);
+        snap.particleX[n] = particles.posX[i] >> 8;
+        snap.particleY[n] = particles.posY[i] >> 8;
+        n += (particles.life[i] != 0); // A dead one is overwritten by the next
+    }
+    snap.particleCount = n;
+
+    snapshots.publish();
+    wakeRenderTask();
+}
+
+// Draws one snapshot and flushes it, unless it is a menu or game-over screen
+// the panel already shows. Touches only the display, the raster, the dirty
+// regions and the HUD cache - never live game state.
+template <typename Config>
+void BasicAstroLib<Config>::renderSnapshot(const Snapshot &snap)
+{
+    bool staticScene = (snap.state == START || snap.state == GAME_OVER);
+    if (staticScene && snap.sceneVersion == drawnSceneVersion)
+        return; // The panel already shows exactly this: no raster, no flush
+    drawnSceneVersion = staticScene ? snap.sceneVersion : 0;
+
+    {
+        ASTRO_PROFILE(profiler, PROFILE_RASTER);
+        rasterSnapshot(snap);
+    }
+    ASTRO_PROFILE(profiler, PROFILE_FLUSH);
+    flushDisplay();
+}
+
+template <typename Config>
+void BasicAstroLib<Config>::rasterSnapshot(const Snapshot &snap)
+{
+    display.clearDisplay();
+    raster.setBuffer(display.getBuffer());
+    frameDirty.clear();
+    if (snap.state != renderedState)
+    {
+        lastFrameDirty.markAll(); // Screen layout changed: resend the whole panel once
+        renderedState = snap.state;
+    }
+    switch (snap.state)
+    {
+    case START:
+        drawStartMenu();
+        break;
+    case GAME:
+    {
+        bool invincible = (snap.ship.lifetime > 0);
+        if (snap.ship.active)
+        {
+            drawShip(snap, invincible);
+        }
+        drawAsteroids(snap);
+        drawParticles(snap);
+        drawBullets(snap);
+        drawUI(snap);
+    }
+    break;
+    case WAVE_CLEAR:
+        drawWaveClear();
+        break;
+    case GAME_OVER:
+        drawGameOverScreen(snap);
+        break;
+    }
+}
+
+// --- Private Method Implementations ---
+
+// --- Core Logic ---
+template <typename Config>
+void BasicAstroLib<Config>::resetGame()
+{
+    score = 0;
+    lives = 3;
+    ship.pos.x = Config::WIDTH / 2.0f;
+    ship.pos.y = Config::HEIGHT / 2.0f;
+    ship.vel.x = 0.0f;
+    ship.vel.y = 0.0f;
+    ship.angle = SHIP_START_ANGLE;
+    ship.radius = SHIP_COLLISION_RADIUS;
+    ship.active = true;
+    snapShipPose();
+    shipSpawnTime = simMillis();
+    ship.lifetime = INVINCIBILITY_DURATION;
+    bullets.clear();
+    asteroids.clear();
+    particles.clear();
+    for (int i = 0; i < Config::STARTING_ASTEROIDS; ++i)
+    {
+        Scalar spawnX, spawnY;
+        do
+        {
+            spawnX = rng.range(0, Config::WIDTH);
+            spawnY = rng.range(0, Config::HEIGHT);
+        } while (circlesOverlap(spawnX - ship.pos.x, spawnY - ship.pos.y, ASTEROID_SIZE_LARGE * 2.5f));
+        spawnAsteroid(ASTEROID_SIZE_LARGE, spawnX, spawnY);
+    }
+    fireButtonPressedLastFrame = true;
+    hyperspaceButtonPressedLastFrame = true;
+    lastHyperspaceTime = simMillis() - HYPERSPACE_COOLDOWN;
+    isThrusting = false;
+    audio.stopAllSounds();
+}
+
+template <typename Config>
+void BasicAstroLib<Config>::handleInput(int joyX, int joyY, bool anyFireButtonDown, bool digitalHyperspaceDown)
+{
+    if (!ship.active)
+    {
+        if (isThrusting)
+        {
+            audio.stopThrustSound();
+            isThrusting = false;
+        }
+        return;
+    }
+
+    // --- Rotation (Variable Speed) ---
+    int xDelta = joyX - JOYSTICK_CENTER;
+    float turnScale = 0.0f;
+    if (abs(xDelta) > JOYSTICK_DEAD_ZONE)
+    {
+        turnScale = (float)(abs(xDelta) - JOYSTICK_DEAD_ZONE) / (JOYSTICK_MAX_THROW - JOYSTICK_DEAD_ZONE);
+        turnScale = max(0.0f, min(1.0f, turnScale));
+        BAngle turn = (BAngle)(tickTurnSpeed * turnScale);
+        if (xDelta < 0)
+        {
+            ship.angle -= turn; // Binary angle: wraps for free
+        }
+        else
+        {
+            ship.angle += turn;
+        }
+    }
+
+    Scalar headingSin, headingCos;
+    sinCos(ship.angle, headingSin, headingCos);
+
+    // --- Thrust (Variable Speed & Sound) ---
+    int yDelta = joyY - JOYSTICK_CENTER;
+    bool wantsToThrust = (yDelta < -JOYSTICK_DEAD_ZONE);
+    float thrustScale = 0.0f;
+    if (wantsToThrust)
+    {
+        thrustScale = (float)(abs(yDelta) - JOYSTICK_DEAD_ZONE) / (JOYSTICK_MAX_THROW - JOYSTICK_DEAD_ZONE);
+        thrustScale = max(0.0f, min(1.0f, thrustScale));
+        Scalar thrust = tickThrust * thrustScale;
+        ship.vel.x += headingCos * thrust;
+        ship.vel.y += headingSin * thrust;
+    }
+    if (wantsToThrust)
+    {
+        spawnExhaust(headingSin, headingCos);
+    }
+    if (wantsToThrust && !isThrusting)
+    {
+        audio.startThrustSound(thrustScale);
+    }
+    else if (!wantsToThrust && isThrusting)
+    {
+        audio.stopThrustSound();
+    }
+    // else if (wantsToThrust && isThrusting) { /* Optional: update pitch */ }
+    isThrusting = wantsToThrust;
+
+    // --- Firing ---
+    unsigned long currentTime = simMillis();
+    if (anyFireButtonDown && !fireButtonPressedLastFrame && (currentTime - lastFireTime > FIRE_DEBOUNCE_DELAY))
+    {
+        int slot = bullets.allocate();
+        if (slot != -1)
+        {
+            Scalar noseDist = ship.radius + 2;
+            bullets.posX[slot] = ship.pos.x + headingCos * noseDist;
+            bullets.posY[slot] = ship.pos.y + headingSin * noseDist;
+            bullets.velX[slot] = (headingCos * Config::BULLET_SPEED) + ship.vel.x;
+            bullets.velY[slot] = (headingSin * Config::BULLET_SPEED) + ship.vel.y;
+            bullets.radius[slot] = BULLET_COLLISION_RADIUS;
+            bullets.lifetime[slot] = bulletLifetimeTicks;
+            bullets.prevX[slot] = bullets.posX[slot];
+            bullets.prevY[slot] = bullets.posY[slot];
+            bullets.size[slot] = 0;
+            lastFireTime = currentTime;
+            audio.playShootSound();
+        }
+    }
+
+    // --- Hyperspace ---
+    if (digitalHyperspaceDown && !hyperspaceButtonPressedLastFrame)
+    {
+        if (currentTime - lastHyperspaceTime > HYPERSPACE_COOLDOWN)
+        {
+            triggerHyperspace();
+            lastHyperspaceTime = currentTime;
+        }
+    }
+}
+
+template <typename Config>
+void BasicAstroLib<Config>::triggerHyperspace()
+{
+    if (!ship.active)
+        return;
+    audio.playHyperspaceSound();
+    int margin = roundToInt(ship.radius * 2);
+    ship.pos.x = rng.range(margin, Config::WIDTH - margin);
+    ship.pos.y = rng.range(margin, Config::HEIGHT - margin);
+    ship.vel.x = 0.0f;
+    ship.vel.y = 0.0f;
+    snapShipPose();
+    shipSpawnTime = simMillis();
+    ship.lifetime = HYPERSPACE_INVINCIBILITY;
+    if (isThrusting)
+    {
+        audio.stopThrustSound();
+        isThrusting = false;
+    }
+}
+
+template <typename Config>
+void BasicAstroLib<Config>::loadHighScore() {
+    // Load the leaderboard from NVS. A unit that only has the old single
+    // high score key starts its leaderboard from that.
+    leaderboard.begin(preferences, preferences.getInt(PREF_KEY_HIGH_SCORE, 0));
+    highScore = leaderboard.best();
+    Serial.print("Loaded HS from NVS: "); Serial.println(highScore); // Debug
+}
+
+template <typename Config>
+void BasicAstroLib<Config>::recordScore(int finalScore) {
+    if (player)
+        return; // Replays never touch NVS
+    leaderboard.submit(finalScore, currentMillis()); // RAM only; committed from update() later
+}
+
+// Writes the leaderboard once it is due, from a menu screen only. With the
+// render task running the write is staged for it instead, so update() never
+// waits on flash.
+template <typename Config>
+void BasicAstroLib<Config>::commitLeaderboard(unsigned long now)
+{
+    collectLeaderboardWrite(now);
+    if (stagedWrite.load(std::memory_order_relaxed) != STAGE_IDLE)
+        return; // Previous write still in flight
+    if ((currentState != START && currentState != GAME_OVER) || !leaderboard.isDue(now))
+        return;
+    if (!renderRunning)
+    {
+        leaderboard.commit(now);
+        return;
+    }
+    if (leaderboard.stage(stagedRecord, stagedSlot))
+    {
+        stagedWrite.store(STAGE_PENDING, std::memory_order_release);
+        wakeRenderTask();
+    }
+}
+
+// Sim side: takes the result of a finished staged write
+template <typename Config>
+void BasicAstroLib<Config>::collectLeaderboardWrite(unsigned long now)
+{
+    uint8_t staged = stagedWrite.load(std::memory_order_acquire);
+    if (staged == STAGE_WRITTEN || staged == STAGE_FAILED)
+    {
+        leaderboard.finishStaged(staged == STAGE_WRITTEN, now);
+        stagedWrite.store(STAGE_IDLE, std::memory_order_relaxed);
+    }
+}
+
+// Sim side: waits out a staged write (or does it, once the render task is
+// gone), so the caller may use NVS directly again
+template <typename Config>
+void BasicAstroLib<Config>::settleLeaderboardWrite()
+{
+    while (renderRunning && stagedWrite.load(std::memory_order_acquire) == STAGE_PENDING)
+    {
+#if defined(ESP32)
+        delay(1);
+#elif defined(ASTRO_HOST_BUILD)
+        std::this_thread::yield();
+#endif
+    }
+    if (stagedWrite.load(std::memory_order_acquire) == STAGE_PENDING)
+        writeStagedLeaderboard();
+    collectLeaderboardWrite(currentMillis());
+}
+
+// Render side (or the sim side once the render task has stopped)
+template <typename Config>
+void BasicAstroLib<Config>::writeStagedLeaderboard()
+{
+    bool written = Leaderboard::writeStaged(preferences, stagedSlot, stagedRecord);
+    stagedWrite.store(written ? STAGE_WRITTEN : STAGE_FAILED, std::memory_order_release);
+}
+
+template <typename Config>
+void BasicAstroLib<Config>::updateGameObjects()
+{
+    unsigned long currentTime = simMillis();
+    if (ship.active)
+    {
+        ship.vel.x *= tickFriction;
+        ship.vel.y *= tickFriction;
+        ship.pos.x += ship.vel.x * tickScale;
+        ship.pos.y += ship.vel.y * tickScale;
+        wrapAround(ship.pos.x, ship.pos.y);
+        if (currentTime - shipSpawnTime > INVINCIBILITY_DURATION)
+        {
+            ship.lifetime = 0;
+        }
+        else
+        {
+            ship.lifetime = INVINCIBILITY_DURATION - (currentTime - shipSpawnTime);
+        }
+    }
+    for (int i = bullets.first(); i >= 0; i = bullets.next(i))
+    {
+        bullets.posX[i] += bullets.velX[i] * tickScale;
+        bullets.posY[i] += bullets.velY[i] * tickScale;
+        bullets.lifetime[i]--;
+        wrapAround(bullets.posX[i], bullets.posY[i]);
+        if (bullets.lifetime[i] <= 0)
+        {
+            bullets.release(i);
+        }
+    }
+    for (int i = asteroids.first(); i >= 0; i = asteroids.next(i))
+    {
+        asteroids.posX[i] += asteroids.velX[i] * tickScale;
+        asteroids.posY[i] += asteroids.velY[i] * tickScale;
+        wrapAround(asteroids.posX[i], asteroids.posY[i]);
+    }
+    particles.update();
+}
+
+template <typename Config>
+void BasicAstroLib<Config>::handleCollisions()
+{
+    asteroidGrid.build(asteroids);
+
+    // --- Bullet-Asteroid Collisions ---
+    for (int i = bullets.first(); i >= 0; i = bullets.next(i))
+    {
+        int j = asteroidGrid.firstHit(asteroids, bullets.posX[i], bullets.posY[i], bullets.radius[i]);
+        if (j >= 0)
+        {
+            // Copy the parent out first: the first fragment may reuse its slot
+            int size = asteroids.size[j];
+            Scalar x = asteroids.posX[j], y = asteroids.posY[j];
+            Scalar vx = asteroids.velX[j], vy = asteroids.velY[j];
+            bullets.release(i);
+            asteroids.release(j);
+            audio.playExplosionSound(); // Play explosion sound
+            spawnDebris(x, y, vx, vy, size * DEBRIS_PER_ASTEROID);
+
+            // Award score
+            if (size == ASTEROID_SIZE_LARGE)
+                score += 20;
+            else if (size == ASTEROID_SIZE_MEDIUM)
+                score += 50;
+            else
+                score += 100;
+
+            // Break asteroid
+            if (size == ASTEROID_SIZE_LARGE)
+            {
+                spawnAsteroid(ASTEROID_SIZE_MEDIUM, x, y, vx, vy);
+                spawnAsteroid(ASTEROID_SIZE_MEDIUM, x, y, vx, vy);
+            }
+            else if (size == ASTEROID_SIZE_MEDIUM)
+            {
+                spawnAsteroid(ASTEROID_SIZE_SMALL, x, y, vx, vy);
+                spawnAsteroid(ASTEROID_SIZE_SMALL, x, y, vx, vy);
+            }
+            // A bullet hits only one asteroid: the lowest-numbered it overlaps
+        }
+    }
+
+    // --- Ship-Asteroid Collisions ---
+    bool currentlyInvincible = (ship.lifetime > 0);
+    if (ship.active && !currentlyInvincible)
+    {
+        int j = asteroidGrid.firstHit(asteroids, ship.pos.x, ship.pos.y, ship.radius);
+        if (j >= 0)
+        {
+            lives--;
+            asteroids.release(j);        // Destroy asteroid on collision
+            audio.playExplosionSound();  // Play explosion sound
+            spawnDebris(ship.pos.x, ship.pos.y, ship.vel.x, ship.vel.y, DEBRIS_PER_SHIP);
+
+            if (lives > 0)
+            {
+                // Respawn: Reset position, velocity, grant invincibility
+                ship.pos.x = Config::WIDTH / 2.0f;
+                ship.pos.y = Config::HEIGHT / 2.0f;
+                ship.vel.x = 0.0f;
+                ship.vel.y = 0.0f;
+                ship.angle = SHIP_START_ANGLE;
+                snapShipPose();
+                shipSpawnTime = simMillis();
+                ship.lifetime = INVINCIBILITY_DURATION;
+            }
+            else
+            {
+                ship.active = false; // Game Over (state change handled in update())
+            }
+            // Ship hits one asteroid per frame
+        }
+    }
+}
+
+template <typename Config>
+bool BasicAstroLib<Config>::checkLevelClear()
+{
+    return asteroids.empty(); // Live count is kept by the pool
+}
+
+template <typename Config>
+void BasicAstroLib<Config>::beginWaveClear()
+{
+    audio.stopAllSounds();
+    currentState = WAVE_CLEAR;
+    waveClearTime = simMillis();
+}
+
+template <typename Config>
+void BasicAstroLib<Config>::spawnNewWave()
+{
+    int num_to_spawn = Config::STARTING_ASTEROIDS + (score / 500);
+    if (num_to_spawn > Config::MAX_ASTEROIDS)
+        num_to_spawn = Config::MAX_ASTEROIDS;
+    for (int i = 0; i < num_to_spawn; ++i)
+    {
+        Scalar spawnX, spawnY;
+        do
+        {
+            spawnX = rng.range(0, Config::WIDTH);
+            spawnY = rng.range(0, Config::HEIGHT);
+        } while (circlesOverlap(spawnX - ship.pos.x, spawnY - ship.pos.y, ASTEROID_SIZE_LARGE * 3.0f));
+        spawnAsteroid(ASTEROID_SIZE_LARGE, spawnX, spawnY);
+    }
+}
+
+// --- Object Management ---
+
+template <typename Config>
+void BasicAstroLib<Config>::spawnAsteroid(int size, Scalar x, Scalar y, Scalar initial_vx, Scalar initial_vy)
+{
+    int slot = asteroids.allocate();
+    if (slot == -1)
+        return; // No space left
+
+    // Determine spawn position (edge or specified point)
+    if (x < 0 || y < 0)
+    { // Spawn at edge if no position specified
+        uint32_t edge = rng.next(); // Bit 0: which pair of edges, bit 1: which of the two
+        if (edge & 1)
+        { // Top/Bottom or Left/Right edge
+            asteroids.posX[slot] = rng.range(0, Config::WIDTH);
+            asteroids.posY[slot] = (edge & 2) ? 0 - size : Config::HEIGHT + size;
+        }
+        else
+        {
+            asteroids.posX[slot] = (edge & 2) ? 0 - size : Config::WIDTH + size;
+            asteroids.posY[slot] = rng.range(0, Config::HEIGHT);
+        }
+    }
+    else
+    { // Spawn at specified position (for fragments)
+        asteroids.posX[slot] = x;
+        asteroids.posY[slot] = y;
+    }
+
+    // Determine velocity (random or based on parent)
+    if (initial_vx == 0 && initial_vy == 0)
+    { // New asteroid
+        Scalar speed = rng.uniform(Config::ASTEROID_SPEED_MIN, Config::ASTEROID_SPEED_MAX);
+        BAngle angle = (BAngle)(rng.next() >> 16); // Full turn
+        Scalar s, c;
+        sinCos(angle, s, c);
+        asteroids.velX[slot] = c * speed;
+        asteroids.velY[slot] = s * speed;
+    }
+    else
+    {                                                    // Fragment - inherit velocity with variation
+        Scalar speed_variation = rng.uniform(0.8f, 1.2f);                                // 0.8x to 1.2x speed
+        BAngle angle_variation = rng.range(-FRAGMENT_ANGLE_SPREAD, FRAGMENT_ANGLE_SPREAD + 1); // +/- 0.25 radians (~14 deg)
+        BAngle parent_angle = fastAtan2(initial_vy, initial_vx);
+        Scalar parent_speed = magnitude(initial_vx, initial_vy);
+        Scalar new_speed = parent_speed * speed_variation;
+        // Ensure minimum speed for fragments
+        if (new_speed < Config::ASTEROID_SPEED_MIN)
+            new_speed = Config::ASTEROID_SPEED_MIN;
+
+        Scalar s, c;
+        sinCos(parent_angle + angle_variation, s, c);
+        asteroids.velX[slot] = c * new_speed;
+        asteroids.velY[slot] = s * new_speed;
+    }
+
+    // Set remaining properties
+    asteroids.radius[slot] = size;
+    asteroids.lifetime[slot] = 0; // Not used
+    asteroids.size[slot] = size;
+    asteroids.prevX[slot] = asteroids.posX[slot];
+    asteroids.prevY[slot] = asteroids.posY[slot];
+    buildAsteroidMesh(asteroidMeshes[slot], size);
+    asteroidGrid.insert(slot, asteroids.posX[slot], asteroids.posY[slot]); // Fragments spawned mid-pass
+}
+
+// Bursts `count` debris particles out of (x, y) in random directions,
+// carried along at half the speed of whatever broke up
+template <typename Config>
+void BasicAstroLib<Config>::spawnDebris(Scalar x, Scalar y, Scalar vx, Scalar vy, int count)
+{
+    float scale = toFloat(tickScale) * 256; // Reference-frame pixels -> Q8.8 per tick
+    float driftX = toFloat(vx) * 0.5f * scale;
+    float driftY = toFloat(vy) * 0.5f * scale;
+    uint16_t px = (uint16_t)(int)(toFloat(x) * 256);
+    uint16_t py = (uint16_t)(int)(toFloat(y) * 256);
+    for (int k = 0; k < count; ++k)
+    {
+        float speed = particleRng.uniform(DEBRIS_SPEED_MIN, DEBRIS_SPEED_MAX) * scale;
+        float s, c;
+        sinCos((BAngle)(particleRng.next() >> 16), s, c);
+        uint8_t life = debrisLifetimeTicks / 2 + particleRng.below(debrisLifetimeTicks / 2 + 1);
+        particles.spawn(px, py, (int16_t)(c * speed + driftX), (int16_t)(s * speed + driftY), life);
+    }
+}
+
+// One exhaust particle per tick out of the back of the ship
+template <typename Config>
+void BasicAstroLib<Config>::spawnExhaust(Scalar headingSin, Scalar headingCos)
+{
+    float scale = toFloat(tickScale) * 256;
+    float sinA = toFloat(headingSin), cosA = toFloat(headingCos);
+    float tail = toFloat(ship.radius) + 1;
+    float jitter = particleRng.uniform(-0.3f, 0.3f);
+    float vx = toFloat(ship.vel.x) - (cosA + sinA * jitter) * EXHAUST_SPEED;
+    float vy = toFloat(ship.vel.y) - (sinA - cosA * jitter) * EXHAUST_SPEED;
+    particles.spawn((uint16_t)(int)((toFloat(ship.pos.x) - cosA * tail) * 256),
+                    (uint16_t)(int)((toFloat(ship.pos.y) - sinA * tail) * 256), (int16_t)(vx * scale),
+                    (int16_t)(vy * scale), exhaustLifetimeTicks);
+}
+
+template <typename Config>
+void BasicAstroLib<Config>::buildAsteroidMesh(AsteroidMesh &mesh, int size)
+{
+    int numVertices = 5 + size / 3; // Vary vertices with size
+    if (numVertices > MAX_ASTEROID_VERTICES)
+        numVertices = MAX_ASTEROID_VERTICES;
+    BAngle angleStep = 65536 / numVertices;
+
+    float jaggedness[MAX_ASTEROID_VERTICES];
+    rng.fillUniform(jaggedness, numVertices, 0.7f, 1.3f);
+
+    mesh.vertexCount = numVertices;
+    for (int v = 0; v < numVertices; ++v)
+    {
+        float s, c;
+        sinCos(v * angleStep, s, c);
+        float radius_variation = size * jaggedness[v];
+        mesh.dx[v] = (int8_t)roundToInt(c * radius_variation);
+        mesh.dy[v] = (int8_t)roundToInt(s * radius_variation);
+    }
+}
+
+// Toroidal playfield: positions stay in [0, WIDTH) x [0, HEIGHT)
+// and the renderer draws the part of an object hanging off one edge
+// entering from the opposite one.
+template <typename Config>
+void BasicAstroLib<Config>::wrapAround(Scalar &x, Scalar &y)
+{
+    if (x < 0)
+        x += Config::WIDTH;
+    else if (x >= Config::WIDTH)
+        x -= Config::WIDTH;
+
+    if (y < 0)
+        y += Config::HEIGHT;
+    else if (y >= Config::HEIGHT)
+        y -= Config::HEIGHT;
+}
+
+// --- Drawing ---
+
+template <typename Config>
+void BasicAstroLib<Config>::drawShip(const Snapshot &snap, bool invincible)
+{
+    const GameObject &ship = snap.ship;
+
+    // Mark before the blink check: a hidden frame still has to erase the last one
+    int extent = roundToInt(ship.radius) + 5; // Nose/flame reach + rounding
+    int centerX = roundToInt(ship.pos.x), centerY = roundToInt(ship.pos.y);
+    frameDirty.markRectWrapped(centerX - extent, centerY - extent, centerX + extent, centerY + extent);
+
+    // Blink if invincible
+    if (invincible && (snap.time / 200) % 2)
+        return;
+
+    // Ship vertices relative to (0,0)
+    float shipRadius = toFloat(ship.radius);
+    float shipX = toFloat(ship.pos.x), shipY = toFloat(ship.pos.y);
+    float p1x = shipRadius + 2, p1y = 0;            // Nose
+    float p2x = -shipRadius, p2y = -shipRadius + 1; // Back left
+    float p3x = -shipRadius, p3y = shipRadius - 1;  // Back right
+
+    // Rotate points (one table lookup shared by every vertex)
+    float sinA, cosA;
+    sinCos(ship.angle, sinA, cosA);
+    rotatePoint(sinA, cosA, p1x, p1y);
+    rotatePoint(sinA, cosA, p2x, p2y);
+    rotatePoint(sinA, cosA, p3x, p3y);
+
+    // Translate to ship position
+    p1x += shipX;
+    p1y += shipY;
+    p2x += shipX;
+    p2y += shipY;
+    p3x += shipX;
+    p3y += shipY;
+
+    // Draw ship triangle
+    raster.triangleWrapped(roundToInt(p1x), roundToInt(p1y), roundToInt(p2x), roundToInt(p2y),
+                           roundToInt(p3x), roundToInt(p3y));
+
+    // Draw thrust flame if thrusting
+    if (snap.thrusting)
+    {
+        float flameX1 = -shipRadius;
+        float flameY1 = -shipRadius / 2;
+        float flameX2 = -shipRadius - 3;
+        float flameY2 = 0;
+        float flameX3 = -shipRadius;
+        float flameY3 = shipRadius / 2;
+        rotatePoint(sinA, cosA, flameX1, flameY1);
+        rotatePoint(sinA, cosA, flameX2, flameY2);
+        rotatePoint(sinA, cosA, flameX3, flameY3);
+        raster.triangleWrapped(
+            roundToInt(shipX + flameX1), roundToInt(shipY + flameY1),
+            roundToInt(shipX + flameX2), roundToInt(shipY + flameY2),
+            roundToInt(shipX + flameX3), roundToInt(shipY + flameY3));
+    }
+}
+
+template <typename Config>
+void BasicAstroLib<Config>::drawAsteroids(const Snapshot &snap)
+{
+    for (int i = 0; i < snap.asteroidCount; ++i)
+    {
+        const AsteroidMesh &mesh = snap.asteroidMesh[i];
+        int centerX = snap.asteroidX[i];
+        int centerY = snap.asteroidY[i];
+        int extent = snap.asteroidSize[i] + snap.asteroidSize[i] * 3 / 10 + 1; // Max jaggedness is 1.3x
+        frameDirty.markRectWrapped(centerX - extent, centerY - extent, centerX + extent, centerY + extent);
+
+        // Draw the cached jagged polygon, starting from the closing edge
+        int lastX = centerX + mesh.dx[mesh.vertexCount - 1];
+        int lastY = centerY + mesh.dy[mesh.vertexCount - 1];
+        for (int v = 0; v < mesh.vertexCount; ++v)
+        {
+            int currentX = centerX + mesh.dx[v];
+            int currentY = centerY + mesh.dy[v];
+            raster.lineWrapped(lastX, lastY, currentX, currentY);
+            lastX = currentX;
+            lastY = currentY;
+        }
+    }
+}
+
+template <typename Config>
+void BasicAstroLib<Config>::drawBullets(const Snapshot &snap)
+{
+    // display.setTextColor(SSD1306_WHITE); // Not needed for pixels
+    for (int i = 0; i < snap.bulletCount; ++i)
+    {
+        int x = snap.bulletX[i], y = snap.bulletY[i];
+        raster.pixelWrapped(x, y);
+        frameDirty.markRectWrapped(x, y, x, y);
+    }
+}
+
+template <typename Config>
+void BasicAstroLib<Config>::drawParticles(const Snapshot &snap)
+{
+    for (int i = 0; i < snap.particleCount; ++i)
+    {
+        int x = snap.particleX[i], y = snap.particleY[i]; // Already wrapped
+        raster.pixel(x, y);
+        frameDirty.markRect(x, y, x, y);
+    }
+}
+
+template <typename Config>
+void BasicAstroLib<Config>::drawUI(const Snapshot &snap)
+{
+    // HUD pixels only change with their values; otherwise the panel already has them
+    bool scoreChanged = hudScoreText.setValue(snap.score);
+    bool highScoreChanged = hudHighScoreText.setValue(snap.highScore);
+    if (scoreChanged || highScoreChanged)
+    {
+        frameDirty.markRect(0, 0, Config::WIDTH - 1, 9); // Score + high score row
+    }
+    if (snap.lives != hudLives)
+    {
+        int icons = max(snap.lives, hudLives); // Cover icons that just disappeared
+        frameDirty.markRect(0, Config::HEIGHT - 9, icons * 9 + 5, Config::HEIGHT - 4);
+        hudLives = snap.lives;
+    }
+
+    // Draw Score (Top Left)
+    raster.columns(1, 1, hudScoreText.columns(), hudScoreText.width());
+
+    // Draw High Score (Top Right)
+    int hsWidth = hudHighScoreText.width();
+    raster.columns(Config::WIDTH - hsWidth - 1, 1, hudHighScoreText.columns(), hsWidth);
+
+    // Draw Lives (Bottom Left - moved from top right)
+    for (int i = 0; i < snap.lives; ++i)
+    {
+        int iconX = 2 + (i * 9);       // Position from left
+        int iconY = Config::HEIGHT - 6; // Position from bottom
+        raster.triangle(iconX, iconY - 3, iconX - 3, iconY + 2, iconX + 3, iconY + 2);
+    }
+}
+
+template <typename Config>
+void BasicAstroLib<Config>::drawStartMenu()
+{
+    frameDirty.markAll();
+    display.setTextSize(2);
+    display.setTextColor(SSD1306_WHITE);
+    display.setCursor(15, COMPACT_HUD ? 0 : 10);
+    display.print("ASTEROIDS"); // Using AstroLib name would require text width calculation
+    display.setTextSize(1);
+    display.setCursor(18, COMPACT_HUD ? 20 : 40);
+    display.print("Press Fire Button");
+    if (!COMPACT_HUD)
+    {
+        display.setCursor(35, 50);
+        display.print("to Start");
+    }
+}
+
+template <typename Config>
+void BasicAstroLib<Config>::drawWaveClear()
+{
+    frameDirty.markRect(30, Config::HEIGHT / 2 - 4, 30 + 13 * 6 - 1, Config::HEIGHT / 2 + 3); // 13 chars, 6x8 font
+    display.setTextSize(1);
+    display.setTextColor(SSD1306_WHITE);
+    display.setCursor(30, Config::HEIGHT / 2 - 4);
+    display.print("Wave Cleared!");
+}
+
+template <typename Config>
+void BasicAstroLib<Config>::drawGameOverScreen(const Snapshot &snap)
+{
+    frameDirty.markAll();
+    display.setTextSize(2);
+    display.setTextColor(SSD1306_WHITE);
+    display.setCursor(10, COMPACT_HUD ? 0 : 10);
+    display.print("GAME OVER");
+
+    display.setTextSize(1);
+    display.setCursor(25, COMPACT_HUD ? 16 : 35);
+    display.print("Score: ");
+    display.print(snap.score);
+
+    display.setCursor(25, COMPACT_HUD ? 24 : 45); // Add High Score display
+    display.print("High:  ");
+    display.print(snap.highScore);
+
+    if (!COMPACT_HUD) // No room for the prompt on a 32-row panel
+    {
+        display.setCursor(18, 55);
+        display.print("Press Fire Button");
+    }
+}
+
+// Sends the frame to the panel. With partial flush attached, only the page
+// windows touched this frame or last frame are written: everything else is
+// blank in both, so the panel already matches.
+template <typename Config>
+void BasicAstroLib<Config>::flushDisplay()
+{
+    if (!flushWire)
+    {
+        display.display();
+        return;
+    }
+
+    Region region = frameDirty;
+    region.merge(lastFrameDirty);
+    lastFrameDirty = frameDirty;
+
+#if defined(I2C_BUFFER_LENGTH)
+    const int chunkSize = I2C_BUFFER_LENGTH - 1; // Leave room for the control byte
+#else
+    const int chunkSize = 31;
+#endif
+    const uint8_t *buffer = display.getBuffer();
+    for (int page = 0; page < Region::PAGES; ++page)
+    {
+        for (int span = 0; span < region.pageSpanCount(page); ++span)
+        {
+            int start = region.spanStart(page, span);
+            int end = region.spanEnd(page, span);
+
+            // Address window: one page, dirty columns only (horizontal addressing)
+            display.ssd1306_command(SSD1306_PAGEADDR);
+            display.ssd1306_command(page);
+            display.ssd1306_command(page);
+            display.ssd1306_command(SSD1306_COLUMNADDR);
+            display.ssd1306_command(start);
+            display.ssd1306_command(end);
+
+            const uint8_t *data = buffer + page * Config::WIDTH + start;
+            int remaining = end - start + 1;
+            while (remaining > 0)
+            {
+                int n = (remaining < chunkSize) ? remaining : chunkSize;
+                flushWire->beginTransmission(flushAddress);
+                flushWire->write((uint8_t)0x40); // Co = 0, D/C = 1: data stream
+                flushWire->write(data, n);
+                flushWire->endTransmission();
+                data += n;
+                remaining -= n;
+            }
+        }
+    }
+}
+
+// --- Utility ---
+
+template <typename Config>
+unsigned long BasicAstroLib<Config>::currentMillis()
+{
+    return timeSource();
+}
+
+template <typename Config>
+unsigned long BasicAstroLib<Config>::simMillis()
+{
+    return simBaseTime + (unsigned long)((uint64_t)tickCount * 1000 / tickRate);
+}
+
+// Rotates (x, y) about the origin; sinA/cosA come from sinCos() so a whole
+// shape shares one lookup.
+template <typename Config>
+void BasicAstroLib<Config>::rotatePoint(float sinA, float cosA, float &x, float &y)
+{
+    float rotatedX = x * cosA - y * sinA;
+    float rotatedY = x * sinA + y * cosA;
+    x = rotatedX;
+    y = rotatedY;
+}
+
+#endif // ASTRO_LIB_IMPL_H
@@ -1,71 +1,102 @@
 #include "AudioEngine.h"
 #include <Arduino.h>
 
+#if defined(ASTRO_HOST_BUILD)
+#include <chrono>
+#endif
+
+// Envelope per voice: start/end frequency (Hz) and length (ms, 0 = held).
+// Thrust takes its frequency from startThrustSound().
+struct VoiceEnvelope {
+    uint16_t startFreq;
+    uint16_t endFreq;
+    uint16_t duration;
+};
+
+static const VoiceEnvelope VOICE_ENVELOPES[VOICE_COUNT] = {
+    {SND_THRUST_FREQ_LOW, SND_THRUST_FREQ_LOW, 0},                          // VOICE_THRUST
+    {SND_SHOOT_FREQ, SND_SHOOT_FREQ, SND_SHORT_DURATION},                   // VOICE_SHOOT
+    {SND_EXPLODE_FREQ, SND_EXPLODE_END_FREQ, SND_SHORT_DURATION * 2},       // VOICE_EXPLOSION
+    {SND_HYPERSPACE_FREQ, SND_HYPERSPACE_END_FREQ, SND_HYPERSPACE_DURATION} // VOICE_HYPERSPACE
+};
+
+// The same sounds for the PCM synthesizer: noise for rumble and
+// explosions, sweeps under decaying levels for shots and hyperspace.
+// Thrust pitch comes from startThrustSound(), scaled by SYNTH_THRUST_SCALE.
+static const SynthPatch SYNTH_PATCHES[VOICE_COUNT] = {
+    {WAVE_NOISE, SND_THRUST_FREQ_LOW, SND_THRUST_FREQ_LOW, 0, 6000, 6000},                         // VOICE_THRUST
+    {WAVE_SQUARE, SND_SHOOT_FREQ, SND_SHOOT_FREQ / 2, SND_SHORT_DURATION, 9000, 0},                // VOICE_SHOOT
+    {WAVE_NOISE, SND_EXPLODE_FREQ * 8, SND_EXPLODE_END_FREQ * 4, SND_SHORT_DURATION * 5, 32767, 0}, // VOICE_EXPLOSION
+    {WAVE_TRIANGLE, SND_HYPERSPACE_FREQ, SND_HYPERSPACE_END_FREQ, SND_HYPERSPACE_DURATION, 16000, 2000} // VOICE_HYPERSPACE
+};
+const uint16_t SYNTH_THRUST_SCALE = 4; // Noise at 400-1000 Hz: a rumble, not a hiss
+
 AudioEngine::AudioEngine() :
-    buzzerPin(-1), initialized(false), thrustSoundActive(false),
-    currentContinuousFreq(0), soundEndTime(0)
-{}
+    buzzerPin(-1), initialized(false), thrustSoundActive(false), timeSource(millis), synth(NULL),
+    queueHead(0), queueTail(0), outputFreq(0), lastStepTime(0), timerRunning(false), timerArmed(false)
+{
+    memset(voices, 0, sizeof(voices));
+#if defined(ESP32)
+    timerHandle = NULL;
+#elif defined(ASTRO_HOST_BUILD)
+    stepCount = 0;
+#endif
+}
+
+AudioEngine::~AudioEngine() {
+    stopTimer();
+}
+
+void AudioEngine::attachTimeSource(TimeSource source) {
+    timeSource = source ? source : millis;
+    lastStepTime = timeSource();
+}
+
+void AudioEngine::attachSynth(PcmSynth &pcm) {
+    synth = &pcm;
+}
 
 void AudioEngine::begin(uint8_t pin) {
     buzzerPin = pin;
-    stopTone(); // Ensure silence initially
+    noTone(buzzerPin); // Ensure silence initially
+    outputFreq = 0;
+    lastStepTime = timeSource();
     initialized = true;
+#if defined(ESP32)
+    startTimer();
+#endif
     Serial.print("Audio Engine initialized on pin: ");
     Serial.println(pin);
-    Serial.println("Using Arduino tone()/noTone()");
+    Serial.println(isTimerDriven() ? "Sequencer on a 1 ms timer" : "Sequencer polled from update()");
 }
 
-void AudioEngine::playTone(uint16_t freq, uint32_t duration) {
-    if (!initialized) return;
-    if (freq > 0) {
-        if (duration > 0) {
-            tone(buzzerPin, freq, duration);
-            soundEndTime = millis() + duration + 5; // Add small buffer
-            currentContinuousFreq = 0;
-        } else {
-            tone(buzzerPin, freq);
-            soundEndTime = 0;
-            currentContinuousFreq = freq;
-        }
-    } else {
-        stopTone();
-    }
-}
+// --- Game Side ---
 
-void AudioEngine::stopTone() {
-    if (!initialized) return;
-    noTone(buzzerPin);
-    currentContinuousFreq = 0;
-    soundEndTime = 0;
+// Queues a command for the sequencer. Never blocks: if the sequencer has
+// fallen 16 commands behind, the newest is dropped.
+bool AudioEngine::post(CommandType type, uint8_t voice, uint16_t freq) {
+    if (!initialized) return false;
+    uint8_t head = queueHead.load(std::memory_order_relaxed);
+    uint8_t next = (head + 1) & (AUDIO_QUEUE_SIZE - 1);
+    if (next == queueTail.load(std::memory_order_acquire)) return false; // Full
+    queue[head].type = type;
+    queue[head].voice = voice;
+    queue[head].freq = freq;
+    queueHead.store(next, std::memory_order_release);
+    if (timerRunning) armTimer();
+    return true;
 }
 
 void AudioEngine::playShootSound() {
-    if (!initialized) return;
-    // Stop continuous thrust if it's playing
-    if (currentContinuousFreq >= SND_THRUST_FREQ_LOW && currentContinuousFreq <= SND_THRUST_FREQ_HIGH) {
-         stopTone();
-    }
-    playTone(SND_SHOOT_FREQ, SND_SHORT_DURATION);
+    post(CMD_PLAY, VOICE_SHOOT);
 }
 
 void AudioEngine::playExplosionSound() {
-    if (!initialized) return;
-    thrustSoundActive = false; // Stop thrust state
-    // Stop continuous thrust if it's playing
-    if (currentContinuousFreq >= SND_THRUST_FREQ_LOW && currentContinuousFreq <= SND_THRUST_FREQ_HIGH) {
-        stopTone();
-    }
-    playTone(SND_EXPLODE_FREQ, SND_SHORT_DURATION * 2);
+    post(CMD_PLAY, VOICE_EXPLOSION);
 }
 
 void AudioEngine::playHyperspaceSound() {
-    if (!initialized) return;
-    thrustSoundActive = false; // Stop thrust state
-    // Stop continuous thrust if it's playing
-    if (currentContinuousFreq >= SND_THRUST_FREQ_LOW && currentContinuousFreq <= SND_THRUST_FREQ_HIGH) {
-        stopTone();
-    }
-    playTone(SND_HYPERSPACE_FREQ, SND_HYPERSPACE_DURATION);
+    post(CMD_PLAY, VOICE_HYPERSPACE);
 }
 
 void AudioEngine::startThrustSound(float intensity) {
@@ -74,45 +105,213 @@ void AudioEngine::startThrustSound(float intensity) {
 
     intensity = max(0.0f, min(1.0f, intensity));
     uint16_t thrustFreq = SND_THRUST_FREQ_LOW + (uint16_t)((SND_THRUST_FREQ_HIGH - SND_THRUST_FREQ_LOW) * intensity);
-
-    unsigned long currentTime = millis();
-    if (soundEndTime == 0 || currentTime >= soundEndTime ) {
-        playTone(thrustFreq, 0);
-    }
+    post(CMD_PLAY, VOICE_THRUST, thrustFreq);
 }
 
 void AudioEngine::stopThrustSound() {
     if (!initialized || !thrustSoundActive) return;
     thrustSoundActive = false;
-    // Only stop if the current continuous tone is within the thrust range
-    if (currentContinuousFreq >= SND_THRUST_FREQ_LOW && currentContinuousFreq <= SND_THRUST_FREQ_HIGH) {
-        stopTone();
-    }
+    post(CMD_STOP, VOICE_THRUST);
 }
 
 void AudioEngine::stopAllSounds() {
      thrustSoundActive = false;
-     stopTone();
+     post(CMD_STOP_ALL, 0);
 }
 
-
 void AudioEngine::update() {
-    if (!initialized) return;
-    unsigned long currentTime = millis();
-
-    // Manage duration for short sounds
-    if (soundEndTime > 0 && currentTime >= soundEndTime) {
-        uint16_t freqJustEnded = currentContinuousFreq; // Might be 0 if tone() stopped it already
-        currentContinuousFreq = 0; // Mark no continuous tone playing
-        soundEndTime = 0; // Clear the end time
-
-        // If thrust is supposed to be active now, restart it
-        if (thrustSoundActive) {
-             startThrustSound(1.0f); // Restart at default intensity
+    if (!initialized || timerRunning) return;
+    unsigned long currentTime = timeSource();
+    uint32_t elapsed = currentTime - lastStepTime;
+    lastStepTime = currentTime;
+    step(min(elapsed, AUDIO_MAX_CATCH_UP));
+}
+
+// --- Sequencer Timer ---
+
+bool AudioEngine::startTimer() {
+    if (timerRunning) return true;
+#if defined(ESP32)
+    // esp_timer callbacks run in a high-priority task rather than an ISR, so
+    // they may call tone(), which takes locks inside the LEDC driver
+    esp_timer_create_args_t args = {};
+    args.callback = timerCallback;
+    args.arg = this;
+    args.name = "astro_audio";
+    if (esp_timer_create(&args, &timerHandle) != ESP_OK) {
+        timerHandle = NULL;
+        return false;
+    }
+    timerRunning = true;
+    if (!sequencerIdle()) armTimer(); // Otherwise the next post() starts it
+    return true;
+#elif defined(ASTRO_HOST_BUILD)
+    timerRunning = true;
+    timerThread = std::thread(&AudioEngine::timerLoop, this);
+    if (!sequencerIdle()) armTimer();
+    return true;
+#else
+    return false; // Keep calling update()
+#endif
+}
+
+void AudioEngine::stopTimer() {
+    if (!timerRunning) return;
+#if defined(ESP32)
+    esp_timer_stop(timerHandle); // Fails harmlessly when idle
+    esp_timer_delete(timerHandle);
+    timerHandle = NULL;
+    timerRunning = false;
+#elif defined(ASTRO_HOST_BUILD)
+    {
+        std::lock_guard<std::mutex> lock(timerLock);
+        timerRunning = false;
+        timerWake.notify_one();
+    }
+    timerThread.join();
+#endif
+    timerArmed = false;
+    lastStepTime = timeSource(); // update() takes over from here
+}
+
+// Game side, after queueing (or the sequencer, re-arming itself): starts
+// the timer unless it is already ticking
+void AudioEngine::armTimer() {
+    if (timerArmed.exchange(true)) return;
+#if defined(ESP32)
+    esp_timer_start_periodic(timerHandle, SND_SEQUENCER_PERIOD_US);
+#elif defined(ASTRO_HOST_BUILD)
+    std::lock_guard<std::mutex> lock(timerLock);
+    timerWake.notify_one();
+#endif
+}
+
+// Sequencer side, with nothing queued or sounding: stops the timer. The
+// timer is stopped before it is disarmed, so a post() that arms it from
+// here on may start it again; one that slipped in just before is caught
+// by the queue check.
+void AudioEngine::idleTimer() {
+#if defined(ESP32)
+    esp_timer_stop(timerHandle);
+#endif
+    timerArmed = false;
+    if (queueTail.load(std::memory_order_relaxed) != queueHead.load(std::memory_order_acquire)) armTimer();
+}
+
+bool AudioEngine::sequencerIdle() {
+    for (int v = 0; v < VOICE_COUNT; ++v) {
+        if (voices[v].active) return false;
+    }
+    return outputFreq == 0 && queueTail.load(std::memory_order_relaxed) == queueHead.load(std::memory_order_acquire);
+}
+
+bool AudioEngine::isTimerDriven() { return timerRunning; }
+
+#if defined(ESP32)
+void AudioEngine::timerCallback(void *arg) {
+    AudioEngine *engine = static_cast<AudioEngine *>(arg);
+    engine->step(SND_SEQUENCER_PERIOD_US / 1000);
+    if (engine->sequencerIdle()) engine->idleTimer();
+}
+#elif defined(ASTRO_HOST_BUILD)
+void AudioEngine::timerLoop() {
+    typedef std::chrono::steady_clock Clock;
+    const Clock::duration period = std::chrono::microseconds(SND_SEQUENCER_PERIOD_US);
+    Clock::time_point next = Clock::now();
+    while (timerRunning) {
+        if (!timerArmed) {
+            // Idle, like the stopped esp_timer: sleep until a post() or stopTimer()
+            std::unique_lock<std::mutex> lock(timerLock);
+            timerWake.wait(lock, [this] { return timerArmed || !timerRunning; });
+            next = Clock::now(); // First step one period after the wake-up
+            continue;
+        }
+        next += period;
+        std::this_thread::sleep_until(next); // Late wakeups catch up with back-to-back steps
+        step(SND_SEQUENCER_PERIOD_US / 1000);
+        stepCount++;
+        if (sequencerIdle()) idleTimer();
+    }
+}
+#endif
+
+// --- Sequencer Side ---
+
+// Advances every voice by `ms`, then starts whatever was queued meanwhile
+// (so a new sound begins at full length), then drives the buzzer with the
+// highest-priority voice still sounding.
+void AudioEngine::step(uint32_t ms) {
+    for (int v = 0; v < VOICE_COUNT; ++v) {
+        Voice &voice = voices[v];
+        if (!voice.active || voice.duration == 0) continue;
+        if (voice.elapsed + ms >= voice.duration) {
+            voice.active = false;
+        } else {
+            voice.elapsed += ms;
+        }
+    }
+
+    uint8_t tail = queueTail.load(std::memory_order_relaxed);
+    while (tail != queueHead.load(std::memory_order_acquire)) {
+        applyCommand(queue[tail]);
+        tail = (tail + 1) & (AUDIO_QUEUE_SIZE - 1);
+        queueTail.store(tail, std::memory_order_release);
+    }
+
+    if (synth) return; // The synthesizer times its own envelopes
+    uint16_t freq = 0;
+    for (int v = VOICE_COUNT - 1; v >= 0; --v) {
+        if (voices[v].active) {
+            freq = voiceFrequency(voices[v]);
+            break;
+        }
+    }
+    if (freq != outputFreq) {
+        if (freq > 0) {
+            tone(buzzerPin, freq);
+        } else {
+            noTone(buzzerPin);
         }
+        outputFreq = freq;
     }
-    // Backup check if thrust should be on but nothing playing
-    else if (thrustSoundActive && currentContinuousFreq == 0 && soundEndTime == 0) {
-        startThrustSound(1.0f); // Restart at default intensity
+}
+
+void AudioEngine::applyCommand(const Command &cmd) {
+    if (synth) {
+        if (cmd.type == CMD_PLAY) {
+            SynthPatch patch = SYNTH_PATCHES[cmd.voice];
+            if (cmd.freq) patch.startFreq = patch.endFreq = cmd.freq * SYNTH_THRUST_SCALE;
+            synth->noteOn(cmd.voice, patch);
+        } else if (cmd.type == CMD_STOP) {
+            synth->noteOff(cmd.voice);
+        } else {
+            synth->allNotesOff();
+        }
     }
+    switch (cmd.type) {
+        case CMD_PLAY: {
+            const VoiceEnvelope &env = VOICE_ENVELOPES[cmd.voice];
+            Voice &voice = voices[cmd.voice];
+            voice.startFreq = cmd.freq ? cmd.freq : env.startFreq;
+            voice.endFreq = cmd.freq ? cmd.freq : env.endFreq;
+            voice.duration = env.duration;
+            voice.elapsed = 0;
+            voice.active = true; // Retriggering restarts the envelope
+            break;
+        }
+        case CMD_STOP:
+            voices[cmd.voice].active = false;
+            break;
+        case CMD_STOP_ALL:
+            for (int v = 0; v < VOICE_COUNT; ++v) voices[v].active = false;
+            break;
+    }
+}
+
+// Sweeps move in SND_SWEEP_STEP ms stairs so the buzzer is not retuned
+// every millisecond
+uint16_t AudioEngine::voiceFrequency(const Voice &voice) {
+    if (voice.startFreq == voice.endFreq || voice.duration == 0) return voice.startFreq;
+    int32_t stepStart = voice.elapsed - voice.elapsed % SND_SWEEP_STEP;
+    return voice.startFreq + ((int32_t)voice.endFreq - voice.startFreq) * stepStart / voice.duration;
 }
\ No newline at end of file
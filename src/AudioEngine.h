@@ -2,13 +2,52 @@
 #define AUDIO_ENGINE_H
 
 #include <Arduino.h>
+#include <atomic>
 #include "GameData.h"
+#include "PcmSynth.h"
+
+#if defined(ESP32)
+#include <esp_timer.h>
+#elif defined(ASTRO_HOST_BUILD)
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#endif
+
+// --- Sequencer ---
+// One voice per sound, each with a fixed priority. The buzzer plays the
+// highest-priority voice that is sounding, so a shot interrupts thrust and
+// thrust comes back when the shot ends. Game code only queues commands;
+// the sequencer applies them and runs the envelopes on its own timer.
+enum AudioVoice { VOICE_THRUST, VOICE_SHOOT, VOICE_EXPLOSION, VOICE_HYPERSPACE, VOICE_COUNT }; // Rising priority
+
+const int AUDIO_QUEUE_SIZE = 16; // Power of two
+const uint32_t AUDIO_MAX_CATCH_UP = 1000; // ms a polled sequencer advances at most per update()
 
 class AudioEngine {
 public:
     AudioEngine();
-    void begin(uint8_t pin);
-    void update();
+    ~AudioEngine();
+    void begin(uint8_t pin); // Starts the sequencer timer where there is one
+    void update();           // Runs the sequencer when no timer drives it
+    void attachTimeSource(TimeSource source); // Defaults to millis()
+
+    // Sequencer timer: esp_timer on ESP32, a std::thread on the host. Without
+    // it the sequencer advances from update(), once per frame. The timer
+    // only ticks while a command is queued or a voice is sounding; it stops
+    // when the sequencer goes idle and the next play or stop call restarts it.
+    bool startTimer();
+    void stopTimer();
+    bool isTimerDriven();
+#if defined(ASTRO_HOST_BUILD)
+    uint32_t hostStepCount() const { return stepCount; } // Timer-driven steps so far
+#endif
+
+    // Sends sounds to a PCM synthesizer instead of tone(): voices are then
+    // mixed rather than taking turns on the buzzer. The sketch's audio
+    // output task calls synth.render() and streams synth.frontBlock() to
+    // I2S/DAC. Attach before begin().
+    void attachSynth(PcmSynth &synth);
 
     void playShootSound();
     void playExplosionSound();
@@ -19,15 +58,58 @@ public:
     void stopAllSounds();
 
 private:
+    enum CommandType : uint8_t { CMD_PLAY, CMD_STOP, CMD_STOP_ALL };
+    struct Command {
+        CommandType type;
+        uint8_t voice;
+        uint16_t freq; // CMD_PLAY of a continuous voice
+    };
+    struct Voice {
+        uint16_t startFreq;
+        uint16_t endFreq;
+        uint16_t duration; // ms; 0 = until stopped
+        uint16_t elapsed;
+        bool active;
+    };
+
     uint8_t buzzerPin;
     bool initialized;
-    bool thrustSoundActive;
-    uint16_t currentContinuousFreq;
-    unsigned long soundEndTime;
+    bool thrustSoundActive; // Game side: thrust requested
+    TimeSource timeSource;
+    PcmSynth *synth; // NULL = buzzer
+
+    // Game -> sequencer (single producer, single consumer)
+    Command queue[AUDIO_QUEUE_SIZE];
+    std::atomic<uint8_t> queueHead; // Next write (producer only)
+    std::atomic<uint8_t> queueTail; // Next read (consumer only)
+
+    // Sequencer side
+    Voice voices[VOICE_COUNT];
+    uint16_t outputFreq; // What the buzzer is playing, 0 = silent
+    unsigned long lastStepTime;
+    std::atomic<bool> timerRunning;
+    std::atomic<bool> timerArmed; // Ticking; whoever sets it starts the timer
+#if defined(ESP32)
+    esp_timer_handle_t timerHandle;
+#elif defined(ASTRO_HOST_BUILD)
+    std::thread timerThread;
+    std::mutex timerLock;
+    std::condition_variable timerWake; // Armed again, or stopping
+    std::atomic<uint32_t> stepCount;
+#endif
 
-    // duration 0 = continuous, intensity for thrust pitch
-    void playTone(uint16_t freq, uint32_t duration = 0);
-    void stopTone();
+    bool post(CommandType type, uint8_t voice, uint16_t freq = 0);
+    void armTimer();
+    void idleTimer();
+    bool sequencerIdle();
+    void step(uint32_t ms);
+    void applyCommand(const Command &cmd);
+    uint16_t voiceFrequency(const Voice &voice);
+#if defined(ESP32)
+    static void timerCallback(void *arg);
+#elif defined(ASTRO_HOST_BUILD)
+    void timerLoop();
+#endif
 };
 
 #endif // AUDIO_ENGINE_H
\ No newline at end of file
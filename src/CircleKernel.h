@@ -0,0 +1,136 @@
+#ifndef CIRCLE_KERNEL_H
+#define CIRCLE_KERNEL_H
+
+#include <Arduino.h>
+#include "GameData.h"
+#include "EntityPool.h"
+
+// Batched circle-overlap test: one probe circle against up to 32 pool slots
+// (one word of the active/candidate mask) at a time. Returns the bitmask of
+// candidate slots that overlap the probe across the screen edges; callers
+// resolve hits lowest bit first, the same order as a slot-by-slot scan.
+// With stopAtFirst the kernel may return early once the lowest hit is known,
+// so only the lowest set bit is meaningful.
+//
+// Width and Height are the wrapping periods (the screen size).
+//
+// Float builds on GCC/Clang targets with SIMD (SSE2/AVX2 hosts, NEON) use
+// vector extensions, 4 lanes per step (8 with AVX). Fixed-point builds and the ESP32 use
+// the scalar loop; both give bit-identical masks.
+#if !defined(ASTRO_FIXED_POINT) && defined(__GNUC__) && (defined(__SSE2__) || defined(__ARM_NEON))
+#define ASTRO_SIMD_KERNEL 1
+#endif
+
+#if defined(ASTRO_SIMD_KERNEL) && defined(__SSE2__)
+#include <immintrin.h>
+#endif
+
+#if defined(__AVX__)
+const int CIRCLE_KERNEL_LANES = 8;
+#else
+const int CIRCLE_KERNEL_LANES = 4;
+#endif
+
+// Shortest signed distance on a wrapping axis of the given period
+inline Scalar toroidalDelta(Scalar d, int period)
+{
+    if (d > period / 2)
+        d -= period;
+    else if (d < -(period / 2))
+        d += period;
+    return d;
+}
+
+template <int Width = SCREEN_WIDTH, int Height = SCREEN_HEIGHT, int Capacity>
+uint32_t circleOverlapMaskScalar(const EntityPool<Capacity> &pool, int word, uint32_t candidates,
+                                 Scalar x, Scalar y, Scalar radius, bool stopAtFirst = false)
+{
+    uint32_t hits = 0;
+    for (uint32_t bits = candidates; bits; bits &= bits - 1)
+    {
+        int lane = countTrailingZeros(bits);
+        int j = word * 32 + lane;
+        Scalar dx = toroidalDelta(x - pool.posX[j], Width);
+        Scalar dy = toroidalDelta(y - pool.posY[j], Height);
+        if (circlesOverlap(dx, dy, radius + pool.radius[j]))
+        {
+            hits |= (uint32_t)1 << lane;
+            if (stopAtFirst)
+                break;
+        }
+    }
+    return hits;
+}
+
+#if defined(ASTRO_SIMD_KERNEL)
+typedef float FloatLanes __attribute__((vector_size(CIRCLE_KERNEL_LANES * sizeof(float))));
+typedef int32_t MaskLanes __attribute__((vector_size(CIRCLE_KERNEL_LANES * sizeof(int32_t))));
+
+// One bit per lane from a -1/0 comparison result
+inline uint32_t laneMask(MaskLanes m)
+{
+#if defined(__AVX__)
+    return _mm256_movemask_ps((__m256)m);
+#elif defined(__SSE2__)
+    return _mm_movemask_ps((__m128)m);
+#else
+    uint32_t bits = 0;
+    for (int k = 0; k < CIRCLE_KERNEL_LANES; ++k)
+        bits |= (uint32_t)(m[k] & 1) << k;
+    return bits;
+#endif
+}
+
+template <int Width = SCREEN_WIDTH, int Height = SCREEN_HEIGHT, int Capacity>
+uint32_t circleOverlapMaskSimd(const EntityPool<Capacity> &pool, int word, uint32_t candidates,
+                               float x, float y, float radius, bool stopAtFirst = false)
+{
+    const float halfW = Width / 2, halfH = Height / 2;
+    uint32_t hits = 0;
+    int base = word * 32;
+    for (int lane = 0; lane < 32 && candidates >> lane; lane += CIRCLE_KERNEL_LANES)
+    {
+        uint32_t laneBits = (candidates >> lane) & ((1u << CIRCLE_KERNEL_LANES) - 1);
+        if (!laneBits)
+            continue; // Nothing to test in this group
+        int j = base + lane;
+        if (j + CIRCLE_KERNEL_LANES > Capacity)
+        {
+            // Ragged end of the pool: finish without reading past the arrays
+            hits |= circleOverlapMaskScalar<Width, Height>(pool, word, candidates & (~0u << lane), x, y, radius, stopAtFirst);
+            break;
+        }
+
+        FloatLanes px, py, pr;
+        memcpy(&px, &pool.posX[j], sizeof(px));
+        memcpy(&py, &pool.posY[j], sizeof(py));
+        memcpy(&pr, &pool.radius[j], sizeof(pr));
+
+        FloatLanes dx = x - px;
+        FloatLanes dy = y - py;
+        // Comparison lanes are -1/0, so these add -period/+period where needed
+        dx += (float)Width * (__builtin_convertvector(dx > halfW, FloatLanes) - __builtin_convertvector(dx < -halfW, FloatLanes));
+        dy += (float)Height * (__builtin_convertvector(dy > halfH, FloatLanes) - __builtin_convertvector(dy < -halfH, FloatLanes));
+        FloatLanes rs = radius + pr;
+        MaskLanes overlap = (dx * dx + dy * dy) < (rs * rs);
+
+        hits |= (laneMask(overlap) & laneBits) << lane;
+        if (hits && stopAtFirst)
+            break;
+    }
+    return hits;
+}
+#endif
+
+template <int Width = SCREEN_WIDTH, int Height = SCREEN_HEIGHT, int Capacity>
+inline uint32_t circleOverlapMask(const EntityPool<Capacity> &pool, int word, uint32_t candidates,
+                                  Scalar x, Scalar y, Scalar radius, bool stopAtFirst = false)
+{
+#if defined(ASTRO_SIMD_KERNEL)
+    return circleOverlapMaskSimd<Width, Height>(pool, word, candidates, x, y, radius, stopAtFirst);
+#else
+    return circleOverlapMaskScalar<Width, Height>(pool, word, candidates, x, y, radius, stopAtFirst);
+#endif
+}
+
+#endif // CIRCLE_KERNEL_H
@@ -0,0 +1,97 @@
+#ifndef COLLISION_GRID_H
+#define COLLISION_GRID_H
+
+#include <Arduino.h>
+#include "GameData.h"
+#include "CircleKernel.h"
+#include "EntityPool.h"
+
+// Cells must be wider than the largest radii sum (large asteroid + ship) plus
+// one pixel of rounding, so any overlapping pair sits in neighbouring cells.
+const int GRID_CELL_SIZE = 16;
+
+// Broad phase for the toroidal playfield: each cell holds a bitset of the
+// pool slots whose centre falls in it. A query ORs the 3x3 block around a
+// point (wrapping at the screen edges) into a candidate mask, so the exact
+// test only runs against nearby objects.
+template <int Capacity, int Width = SCREEN_WIDTH, int Height = SCREEN_HEIGHT>
+class CollisionGrid {
+public:
+    static const int WORDS = EntityPool<Capacity>::WORDS;
+    static const int GRID_COLS = Width / GRID_CELL_SIZE;
+    static const int GRID_ROWS = Height / GRID_CELL_SIZE;
+
+    void build(const EntityPool<Capacity> &pool)
+    {
+        memset(cells, 0, sizeof(cells));
+        for (int i = pool.first(); i >= 0; i = pool.next(i))
+            insert(i, pool.posX[i], pool.posY[i]);
+    }
+
+    // Adds a slot spawned after build(). A slot released and reused keeps its
+    // old cell bit too; that only costs one extra exact test.
+    void insert(int slot, Scalar x, Scalar y)
+    {
+        cells[cellIndex(cellColumn(x), cellRow(y))][slot >> 5] |= (uint32_t)1 << (slot & 31);
+    }
+
+    // Slots near (x, y), masked to the ones still active in the pool
+    void candidates(const EntityPool<Capacity> &pool, Scalar x, Scalar y, uint32_t *mask) const
+    {
+        int col = cellColumn(x), row = cellRow(y);
+        for (int w = 0; w < WORDS; ++w)
+            mask[w] = 0;
+        for (int dr = -1; dr <= 1; ++dr)
+        {
+            int r = (row + dr + GRID_ROWS) % GRID_ROWS;
+            for (int dc = -1; dc <= 1; ++dc)
+            {
+                const uint32_t *cell = cells[cellIndex((col + dc + GRID_COLS) % GRID_COLS, r)];
+                for (int w = 0; w < WORDS; ++w)
+                    mask[w] |= cell[w];
+            }
+        }
+        for (int w = 0; w < WORDS; ++w)
+            mask[w] &= pool.activeWord(w);
+    }
+
+    // Lowest active slot whose circle overlaps (x, y, radius) across the
+    // screen edges, or -1. Lowest-first matches the old brute-force order.
+    int firstHit(const EntityPool<Capacity> &pool, Scalar x, Scalar y, Scalar radius) const
+    {
+        uint32_t mask[WORDS];
+        candidates(pool, x, y, mask);
+        for (int w = 0; w < WORDS; ++w)
+        {
+            if (!mask[w])
+                continue;
+            uint32_t hits = circleOverlapMask<Width, Height>(pool, w, mask[w], x, y, radius, true);
+            if (hits)
+                return w * 32 + countTrailingZeros(hits);
+        }
+        return -1;
+    }
+
+private:
+    uint32_t cells[GRID_COLS * GRID_ROWS][WORDS];
+
+    static int cellIndex(int col, int row) { return row * GRID_COLS + col; }
+
+    // Freshly spawned objects can sit just off-screen until their next
+    // wrapAround(), so wrap here as well
+    static int cellColumn(Scalar x)
+    {
+        int px = roundToInt(x) % Width;
+        return (px < 0 ? px + Width : px) / GRID_CELL_SIZE;
+    }
+
+    static int cellRow(Scalar y)
+    {
+        int py = roundToInt(y) % Height;
+        return (py < 0 ? py + Height : py) / GRID_CELL_SIZE;
+    }
+
+    static_assert(Width % GRID_CELL_SIZE == 0 && Height % GRID_CELL_SIZE == 0, "Screen must be whole grid cells");
+};
+
+#endif // COLLISION_GRID_H
@@ -0,0 +1,181 @@
+#ifndef DIRTY_REGION_H
+#define DIRTY_REGION_H
+
+#include <Arduino.h>
+#include "GameData.h"
+
+const int DIRTY_SPANS_PER_PAGE = 4;
+const int DIRTY_SPAN_MERGE_GAP = 8; // Columns: cheaper to resend than to open another window
+
+// Tracks which part of the framebuffer changed, as a few column spans per
+// SSD1306 page - the same shape as the controller's addressing windows.
+// DirtyRegion covers the default 128x64 panel.
+template <int Width = SCREEN_WIDTH, int Height = SCREEN_HEIGHT>
+class BasicDirtyRegion {
+public:
+    static const int PAGES = Height / 8;
+
+    BasicDirtyRegion();
+
+    void clear();
+    void markAll();
+    // Inclusive pixel rectangle; clipped to the screen
+    void markRect(int x0, int y0, int x1, int y1);
+    // Same, plus the copies a toroidal draw puts on the opposite edges
+    void markRectWrapped(int x0, int y0, int x1, int y1);
+    void merge(const BasicDirtyRegion &other);
+
+    bool isPageDirty(int page) const { return spanCount[page] > 0; }
+    int pageSpanCount(int page) const { return spanCount[page]; }
+    uint8_t spanStart(int page, int span) const { return spanStarts[page][span]; }
+    uint8_t spanEnd(int page, int span) const { return spanEnds[page][span]; }
+    int byteCount() const; // Framebuffer bytes covered
+
+private:
+    uint8_t spanCount[PAGES];
+    uint8_t spanStarts[PAGES][DIRTY_SPANS_PER_PAGE];
+    uint8_t spanEnds[PAGES][DIRTY_SPANS_PER_PAGE];
+
+    void addSpan(int page, int x0, int x1);
+
+    static_assert(Height % 8 == 0 && Width <= 256, "Spans are page-aligned and stored as bytes");
+};
+
+typedef BasicDirtyRegion<> DirtyRegion;
+
+template <int Width, int Height>
+BasicDirtyRegion<Width, Height>::BasicDirtyRegion()
+{
+    clear();
+}
+
+template <int Width, int Height>
+void BasicDirtyRegion<Width, Height>::clear()
+{
+    for (int page = 0; page < PAGES; ++page)
+        spanCount[page] = 0;
+}
+
+template <int Width, int Height>
+void BasicDirtyRegion<Width, Height>::markAll()
+{
+    for (int page = 0; page < PAGES; ++page)
+    {
+        spanCount[page] = 1;
+        spanStarts[page][0] = 0;
+        spanEnds[page][0] = Width - 1;
+    }
+}
+
+template <int Width, int Height>
+void BasicDirtyRegion<Width, Height>::markRect(int x0, int y0, int x1, int y1)
+{
+    // Clip
+    if (x0 < 0)
+        x0 = 0;
+    if (y0 < 0)
+        y0 = 0;
+    if (x1 > Width - 1)
+        x1 = Width - 1;
+    if (y1 > Height - 1)
+        y1 = Height - 1;
+    if (x0 > x1 || y0 > y1)
+        return; // Entirely off-screen
+
+    for (int page = y0 >> 3; page <= (y1 >> 3); ++page)
+        addSpan(page, x0, x1);
+}
+
+template <int Width, int Height>
+void BasicDirtyRegion<Width, Height>::markRectWrapped(int x0, int y0, int x1, int y1)
+{
+    markRect(x0, y0, x1, y1);
+    int shiftX = (x0 < 0) ? Width : (x1 >= Width) ? -Width : 0;
+    int shiftY = (y0 < 0) ? Height : (y1 >= Height) ? -Height : 0;
+    if (shiftX)
+        markRect(x0 + shiftX, y0, x1 + shiftX, y1);
+    if (shiftY)
+        markRect(x0, y0 + shiftY, x1, y1 + shiftY);
+    if (shiftX && shiftY)
+        markRect(x0 + shiftX, y0 + shiftY, x1 + shiftX, y1 + shiftY);
+}
+
+template <int Width, int Height>
+void BasicDirtyRegion<Width, Height>::merge(const BasicDirtyRegion &other)
+{
+    for (int page = 0; page < PAGES; ++page)
+    {
+        for (int i = 0; i < other.spanCount[page]; ++i)
+            addSpan(page, other.spanStarts[page][i], other.spanEnds[page][i]);
+    }
+}
+
+template <int Width, int Height>
+int BasicDirtyRegion<Width, Height>::byteCount() const
+{
+    int bytes = 0;
+    for (int page = 0; page < PAGES; ++page)
+    {
+        for (int i = 0; i < spanCount[page]; ++i)
+            bytes += spanEnds[page][i] - spanStarts[page][i] + 1;
+    }
+    return bytes;
+}
+
+template <int Width, int Height>
+void BasicDirtyRegion<Width, Height>::addSpan(int page, int x0, int x1)
+{
+    uint8_t *starts = spanStarts[page];
+    uint8_t *ends = spanEnds[page];
+    for (;;)
+    {
+        // Absorb every span that overlaps or sits within the merge gap
+        int kept = 0;
+        for (int i = 0; i < spanCount[page]; ++i)
+        {
+            if (starts[i] <= x1 + DIRTY_SPAN_MERGE_GAP && x0 <= ends[i] + DIRTY_SPAN_MERGE_GAP)
+            {
+                if (starts[i] < x0)
+                    x0 = starts[i];
+                if (ends[i] > x1)
+                    x1 = ends[i];
+            }
+            else
+            {
+                starts[kept] = starts[i];
+                ends[kept] = ends[i];
+                kept++;
+            }
+        }
+        spanCount[page] = kept;
+
+        if (kept < DIRTY_SPANS_PER_PAGE)
+        {
+            starts[kept] = x0;
+            ends[kept] = x1;
+            spanCount[page] = kept + 1;
+            return;
+        }
+
+        // Page full: fold the closest span into this one and try again
+        int closest = 0, closestGap = Width;
+        for (int i = 0; i < kept; ++i)
+        {
+            int gap = (starts[i] > x1) ? starts[i] - x1 : x0 - ends[i];
+            if (gap < closestGap)
+            {
+                closestGap = gap;
+                closest = i;
+            }
+        }
+        if (starts[closest] < x0)
+            x0 = starts[closest];
+        if (ends[closest] > x1)
+            x1 = ends[closest];
+        starts[closest] = starts[kept - 1];
+        ends[closest] = ends[kept - 1];
+        spanCount[page] = kept - 1;
+    }
+}
+
+#endif // DIRTY_REGION_H
@@ -0,0 +1,130 @@
+#ifndef ENTITY_POOL_H
+#define ENTITY_POOL_H
+
+#include <Arduino.h>
+#include "GameData.h"
+
+inline int countTrailingZeros(uint32_t bits)
+{
+    return __builtin_ctz(bits); // bits != 0
+}
+
+// Fixed-capacity pool of moving objects stored as structure-of-arrays.
+// Liveness is a bitmask, so finding a free slot or walking the live ones
+// costs one count-trailing-zeros per 32 slots instead of a scan of every
+// slot, and count() is O(1).
+//
+// Iterate live slots in ascending order with:
+//     for (int i = pool.first(); i >= 0; i = pool.next(i))
+template <int Capacity>
+class EntityPool {
+public:
+    static const int CAPACITY = Capacity;
+    static const int WORDS = (Capacity + 31) / 32;
+
+    // --- Per-slot data (valid only while the slot is active) ---
+    Scalar posX[Capacity];
+    Scalar posY[Capacity];
+    Scalar velX[Capacity];
+    Scalar velY[Capacity];
+    Scalar prevX[Capacity]; // Position at the start of the current tick
+    Scalar prevY[Capacity]; // (render interpolation)
+    Scalar radius[Capacity];
+    int32_t lifetime[Capacity]; // Ticks: grows with setTickRate(), past int16_t at high rates
+    int8_t size[Capacity];
+
+    EntityPool() { clear(); }
+
+    void clear()
+    {
+        for (int w = 0; w < WORDS; ++w)
+            active[w] = 0;
+        activeCount = 0;
+    }
+
+    // Claims the lowest free slot; -1 when full
+    int allocate()
+    {
+        for (int w = 0; w < WORDS; ++w)
+        {
+            uint32_t freeBits = ~active[w];
+            if (freeBits)
+            {
+                int i = w * 32 + countTrailingZeros(freeBits);
+                if (i >= Capacity)
+                    return -1; // Padding bits of the last word
+                active[w] |= (uint32_t)1 << (i & 31);
+                activeCount++;
+                return i;
+            }
+        }
+        return -1;
+    }
+
+    void release(int i)
+    {
+        uint32_t bit = (uint32_t)1 << (i & 31);
+        if (active[i >> 5] & bit)
+        {
+            active[i >> 5] &= ~bit;
+            activeCount--;
+        }
+    }
+
+    bool isActive(int i) const { return (active[i >> 5] >> (i & 31)) & 1; }
+    int count() const { return activeCount; }
+    bool empty() const { return activeCount == 0; }
+    uint32_t activeWord(int w) const { return active[w]; }
+
+    // Zeroes the data of every free slot, so two pools holding the same
+    // live objects are byte-identical
+    void zeroFree()
+    {
+        for (int i = 0; i < Capacity; ++i)
+        {
+            if (isActive(i))
+                continue;
+            posX[i] = posY[i] = velX[i] = velY[i] = prevX[i] = prevY[i] = radius[i] = 0;
+            lifetime[i] = 0;
+            size[i] = 0;
+        }
+    }
+
+    // False for liveness bits this pool can never hold: a bit past Capacity,
+    // or count() disagreeing with the bits (a damaged copy)
+    bool consistent() const
+    {
+        int bits = 0;
+        for (int w = 0; w < WORDS; ++w)
+            bits += __builtin_popcount(active[w]);
+        uint32_t padding = (Capacity % 32) ? ~(uint32_t)0 << (Capacity % 32) : 0;
+        return bits == activeCount && (active[WORDS - 1] & padding) == 0;
+    }
+
+    // Lowest active slot, or -1
+    int first() const { return nextFrom(0); }
+
+    // Next active slot after i, or -1. Slots activated behind i are skipped.
+    int next(int i) const { return nextFrom(i + 1); }
+
+private:
+    uint32_t active[WORDS];
+    int activeCount;
+
+    int nextFrom(int i) const
+    {
+        if (i >= Capacity)
+            return -1;
+        int w = i >> 5;
+        uint32_t bits = active[w] & (~(uint32_t)0 << (i & 31));
+        while (!bits)
+        {
+            if (++w >= WORDS)
+                return -1;
+            bits = active[w];
+        }
+        return w * 32 + countTrailingZeros(bits);
+    }
+};
+
+#endif // ENTITY_POOL_H
@@ -0,0 +1,100 @@
+// FastRandom.h
+#ifndef FAST_RANDOM_H
+#define FAST_RANDOM_H
+
+#include <stdint.h>
+
+// --- Per-Instance Generator ---
+// xoshiro128** (Blackman & Vigna): 128 bits of state, period 2^128 - 1, a
+// handful of shifts and one multiply per 32-bit output. Each game owns one,
+// so a seed reproduces the same game regardless of what else calls random().
+class FastRandom {
+public:
+    explicit FastRandom(uint32_t seedValue = 1) { seed(seedValue); }
+
+    // Expands a 32-bit seed with splitmix32, so nearby seeds give unrelated
+    // streams and the state is never all zero.
+    void seed(uint32_t seedValue)
+    {
+        for (int i = 0; i < 4; ++i)
+        {
+            seedValue += 0x9E3779B9u;
+            uint32_t z = seedValue;
+            z = (z ^ (z >> 16)) * 0x85EBCA6Bu;
+            z = (z ^ (z >> 13)) * 0xC2B2AE35u;
+            s[i] = z ^ (z >> 16);
+        }
+        if (!(s[0] | s[1] | s[2] | s[3]))
+            s[0] = 1;
+    }
+
+    uint32_t next()
+    {
+        uint32_t result = rotl(s[1] * 5, 7) * 9;
+        uint32_t t = s[1] << 9;
+        s[2] ^= s[0];
+        s[3] ^= s[1];
+        s[1] ^= s[2];
+        s[0] ^= s[3];
+        s[2] ^= t;
+        s[3] = rotl(s[3], 11);
+        return result;
+    }
+
+    // Unbiased integer in [0, n) (Lemire's multiply-shift with rejection).
+    // The rejection branch is taken with probability below n / 2^32.
+    uint32_t below(uint32_t n)
+    {
+        uint64_t m = (uint64_t)next() * n;
+        uint32_t low = (uint32_t)m;
+        if (low < n)
+        {
+            uint32_t threshold = (0u - n) % n;
+            while (low < threshold)
+            {
+                m = (uint64_t)next() * n;
+                low = (uint32_t)m;
+            }
+        }
+        return (uint32_t)(m >> 32);
+    }
+
+    // Same contract as Arduino's random(min, max): [howsmall, howbig)
+    long range(long howsmall, long howbig)
+    {
+        if (howsmall >= howbig)
+            return howsmall;
+        return howsmall + (long)below((uint32_t)(howbig - howsmall));
+    }
+
+    // [0, 1) with 24 random bits: exact in a float, no division
+    float nextFloat() { return (next() >> 8) * (1.0f / 16777216.0f); }
+    float uniform(float lo, float hi) { return lo + (hi - lo) * nextFloat(); }
+
+    // --- Batch Fill ---
+    // For spawn parameters and meshes: one call per object instead of one
+    // per value, with the state kept in registers across the loop.
+    void fill(uint32_t *out, int n)
+    {
+        for (int i = 0; i < n; ++i)
+            out[i] = next();
+    }
+    void fillRange(int32_t *out, int n, int32_t lo, int32_t hi)
+    {
+        for (int i = 0; i < n; ++i)
+            out[i] = (int32_t)range(lo, hi);
+    }
+    void fillUniform(float *out, int n, float lo, float hi)
+    {
+        float span = hi - lo;
+        for (int i = 0; i < n; ++i)
+            out[i] = lo + span * nextFloat();
+    }
+
+private:
+    uint32_t s[4];
+
+    static uint32_t rotl(uint32_t x, int k) { return (x << k) | (x >> (32 - k)); }
+};
+
+#endif // FAST_RANDOM_H
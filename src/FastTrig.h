@@ -0,0 +1,164 @@
+// FastTrig.h
+#ifndef FAST_TRIG_H
+#define FAST_TRIG_H
+
+#include <stdint.h>
+#include "FixedPoint.h"
+
+// --- Binary Angles ---
+// A full turn is 65536 units, so wrap-around is plain uint16_t overflow.
+// Lookups use the top 10 bits (1024 steps per turn) and linearly
+// interpolate the remaining 6.
+typedef uint16_t BAngle;
+
+const BAngle BANGLE_QUARTER = 0x4000; // 90 degrees
+const BAngle BANGLE_HALF = 0x8000;    // 180 degrees
+
+constexpr BAngle radiansToBAngle(double radians)
+{
+    return (BAngle)(int32_t)(radians * (65536.0 / 6.28318530717958647692) + (radians >= 0 ? 0.5 : -0.5));
+}
+
+constexpr float bangleToRadians(BAngle angle)
+{
+    return angle * (6.28318530717958647692f / 65536.0f);
+}
+
+// --- Compile-Time Tables ---
+// Generated by constexpr evaluation (C++11-compatible), so they land in
+// flash with no startup cost and no libm dependency.
+namespace FastTrigDetail {
+
+constexpr double PI_D = 3.14159265358979323846;
+
+// sin(x) for 0 <= x <= pi/2: Taylor series in Horner form (error < 1e-12)
+constexpr double sinSeries(double x, double x2)
+{
+    return x * (1 - x2 / 6 * (1 - x2 / 20 * (1 - x2 / 42 * (1 - x2 / 72 * (1 - x2 / 110 * (1 - x2 / 156 * (1 - x2 / 210)))))));
+}
+
+// atan(u) for |u| <= 0.5: alternating series u - u^3/3 + u^5/5 - ...
+constexpr double atanSeries(double u2, double term, int n)
+{
+    return n > 41 ? 0 : term / n - atanSeries(u2, term * u2, n + 2);
+}
+
+// atan(t) for 0 <= t <= 1, reduced around atan(0.5) to keep the series short
+constexpr double atanUnit(double t)
+{
+    return 0.46364760900080611621 + atanSeries(((t - 0.5) / (1 + 0.5 * t)) * ((t - 0.5) / (1 + 0.5 * t)),
+                                               (t - 0.5) / (1 + 0.5 * t), 1);
+}
+
+// Quarter-wave sine in Q15, 256 steps per quadrant
+constexpr int16_t sineEntry(int i)
+{
+    return (int16_t)(sinSeries(i * PI_D / 512, (i * PI_D / 512) * (i * PI_D / 512)) * 32767 + 0.5);
+}
+
+// atan(i / 256) as a BAngle
+constexpr uint16_t atanEntry(int i)
+{
+    return (uint16_t)(atanUnit(i / 256.0) * (65536 / (2 * PI_D)) + 0.5);
+}
+
+template <int... Is> struct IndexList {};
+template <int N, int... Is> struct MakeIndexList : MakeIndexList<N - 1, N - 1, Is...> {};
+template <int... Is> struct MakeIndexList<0, Is...> { typedef IndexList<Is...> Type; };
+
+template <typename List> struct Tables;
+template <int... Is> struct Tables<IndexList<Is...> > {
+    static constexpr int16_t sine[sizeof...(Is)] = { sineEntry(Is)... };
+    static constexpr uint16_t atan[sizeof...(Is)] = { atanEntry(Is)... };
+};
+template <int... Is> constexpr int16_t Tables<IndexList<Is...> >::sine[sizeof...(Is)];
+template <int... Is> constexpr uint16_t Tables<IndexList<Is...> >::atan[sizeof...(Is)];
+
+// 256 steps + endpoint + one guard entry so interpolation never branches
+typedef Tables<MakeIndexList<258>::Type> TrigTables;
+
+} // namespace FastTrigDetail
+
+// --- Sine / Cosine ---
+
+// sin(angle) in Q15 (-32767..32767)
+inline int16_t sinQ15(BAngle angle)
+{
+    uint16_t q = angle & 0x3FFF;
+    if (angle & BANGLE_QUARTER)
+        q = BANGLE_QUARTER - q; // Mirror 2nd/4th quadrant
+    const int16_t *t = FastTrigDetail::TrigTables::sine + (q >> 6);
+    int16_t v = t[0] + (((t[1] - t[0]) * (q & 0x3F)) >> 6);
+    return (angle & BANGLE_HALF) ? -v : v;
+}
+
+inline int16_t cosQ15(BAngle angle)
+{
+    return sinQ15(angle + BANGLE_QUARTER);
+}
+
+// Scalar versions: one call gives both, for rotating several points at once
+inline void sinCos(BAngle angle, float &s, float &c)
+{
+    s = sinQ15(angle) * (1.0f / 32767);
+    c = cosQ15(angle) * (1.0f / 32767);
+}
+
+inline void sinCos(BAngle angle, Fixed &s, Fixed &c)
+{
+    int32_t sv = sinQ15(angle), cv = cosQ15(angle);
+    s = Fixed::fromRaw(sv * 2 + (sv >> 14)); // Q15 -> Q16, 32767 maps to 1.0 - 1ulp
+    c = Fixed::fromRaw(cv * 2 + (cv >> 14));
+}
+
+// --- atan2 ---
+
+// Angle of the vector (x, y). Octant reduction + interpolated table,
+// error below 0.01 degrees. Integer inputs of any magnitude.
+inline BAngle fastAtan2(int32_t y, int32_t x)
+{
+    if (x == 0 && y == 0)
+        return 0;
+    uint32_t ax = (x < 0) ? 0u - (uint32_t)x : (uint32_t)x;
+    uint32_t ay = (y < 0) ? 0u - (uint32_t)y : (uint32_t)y;
+    bool steep = ay > ax;
+    if (steep)
+    {
+        uint32_t tmp = ax;
+        ax = ay;
+        ay = tmp;
+    }
+    while (ax > 0xFFFF) // Keep (ay << 16) inside 32 bits
+    {
+        ax >>= 1;
+        ay >>= 1;
+    }
+    uint32_t ratio = (ay << 16) / ax; // 0..65536 == tan in Q16
+    const uint16_t *t = FastTrigDetail::TrigTables::atan + (ratio >> 8);
+    BAngle angle = t[0] + (((t[1] - t[0]) * (ratio & 0xFF)) >> 8);
+    if (steep)
+        angle = BANGLE_QUARTER - angle;
+    if (x < 0)
+        angle = BANGLE_HALF - angle;
+    if (y < 0)
+        angle = -angle;
+    return angle;
+}
+
+inline BAngle fastAtan2(Fixed y, Fixed x)
+{
+    return fastAtan2(y.getRaw(), x.getRaw());
+}
+
+inline BAngle fastAtan2(float y, float x)
+{
+    float ax = (x < 0) ? -x : x;
+    float ay = (y < 0) ? -y : y;
+    float big = (ax > ay) ? ax : ay;
+    if (big == 0)
+        return 0;
+    float scale = 1073741824.0f / big; // Map onto the integer path's range
+    return fastAtan2((int32_t)(y * scale), (int32_t)(x * scale));
+}
+
+#endif // FAST_TRIG_H
@@ -0,0 +1,108 @@
+// FixedPoint.h
+#ifndef FIXED_POINT_H
+#define FIXED_POINT_H
+
+#include <stdint.h>
+#include <math.h>
+
+// --- Q16.16 Fixed-Point Number ---
+// 16 integer bits, 16 fraction bits. Plenty for a 128x64 playfield and lets
+// physics run on the integer ALU instead of the FPU/libm.
+// Converts implicitly FROM int/float (so tuning constants read naturally),
+// but never implicitly back - use toFloat()/toInt()/roundToInt().
+class Fixed {
+public:
+    static const int FRAC_BITS = 16;
+    static const int32_t ONE = 1 << FRAC_BITS;
+
+    constexpr Fixed() : raw(0) {}
+    constexpr Fixed(int v) : raw((int32_t)v * ONE) {}
+    constexpr Fixed(long v) : raw((int32_t)v * ONE) {}
+    constexpr Fixed(float v) : raw((int32_t)(v * ONE + (v >= 0 ? 0.5f : -0.5f))) {}
+    constexpr Fixed(double v) : raw((int32_t)(v * ONE + (v >= 0 ? 0.5 : -0.5))) {}
+
+    static constexpr Fixed fromRaw(int32_t r) { return Fixed(r, RawTag()); }
+    constexpr int32_t getRaw() const { return raw; }
+
+    constexpr float toFloat() const { return raw * (1.0f / ONE); }
+    constexpr int toInt() const { return raw >> FRAC_BITS; } // Floor
+    constexpr int roundToInt() const { return (raw + (ONE / 2)) >> FRAC_BITS; }
+
+    // --- Arithmetic ---
+    friend constexpr Fixed operator+(Fixed a, Fixed b) { return fromRaw(a.raw + b.raw); }
+    friend constexpr Fixed operator-(Fixed a, Fixed b) { return fromRaw(a.raw - b.raw); }
+    friend constexpr Fixed operator*(Fixed a, Fixed b) { return fromRaw((int32_t)(((int64_t)a.raw * b.raw) >> FRAC_BITS)); }
+    friend constexpr Fixed operator/(Fixed a, Fixed b) { return fromRaw((int32_t)(((int64_t)a.raw << FRAC_BITS) / b.raw)); }
+    constexpr Fixed operator-() const { return fromRaw(-raw); }
+
+    Fixed &operator+=(Fixed o) { raw += o.raw; return *this; }
+    Fixed &operator-=(Fixed o) { raw -= o.raw; return *this; }
+    Fixed &operator*=(Fixed o) { *this = *this * o; return *this; }
+    Fixed &operator/=(Fixed o) { *this = *this / o; return *this; }
+
+    // --- Comparison ---
+    friend constexpr bool operator==(Fixed a, Fixed b) { return a.raw == b.raw; }
+    friend constexpr bool operator!=(Fixed a, Fixed b) { return a.raw != b.raw; }
+    friend constexpr bool operator<(Fixed a, Fixed b) { return a.raw < b.raw; }
+    friend constexpr bool operator>(Fixed a, Fixed b) { return a.raw > b.raw; }
+    friend constexpr bool operator<=(Fixed a, Fixed b) { return a.raw <= b.raw; }
+    friend constexpr bool operator>=(Fixed a, Fixed b) { return a.raw >= b.raw; }
+
+private:
+    struct RawTag {};
+    constexpr Fixed(int32_t r, RawTag) : raw(r) {}
+    int32_t raw;
+};
+
+// --- Scalar Helpers ---
+// Overloaded for float and Fixed so game code compiles in either mode.
+inline float toFloat(float v) { return v; }
+inline float toFloat(Fixed v) { return v.toFloat(); }
+
+inline int roundToInt(float v) { return (int)(v >= 0 ? v + 0.5f : v - 0.5f); }
+inline int roundToInt(Fixed v) { return v.roundToInt(); }
+
+// Circle overlap test: dx^2 + dy^2 < r^2. The Fixed version squares the raw
+// values in 64 bits so large offsets can't overflow the Q16.16 range.
+inline bool circlesOverlap(float dx, float dy, float radiiSum)
+{
+    return dx * dx + dy * dy < radiiSum * radiiSum;
+}
+
+inline bool circlesOverlap(Fixed dx, Fixed dy, Fixed radiiSum)
+{
+    int64_t x = dx.getRaw(), y = dy.getRaw(), r = radiiSum.getRaw();
+    return x * x + y * y < r * r;
+}
+
+// Vector length. The Fixed version takes an integer square root of the
+// 64-bit raw sum (Q32), which lands back in Q16.
+inline float magnitude(float x, float y)
+{
+    return sqrtf(x * x + y * y);
+}
+
+inline Fixed magnitude(Fixed x, Fixed y)
+{
+    int64_t rx = x.getRaw(), ry = y.getRaw();
+    uint64_t sq = (uint64_t)(rx * rx + ry * ry);
+    uint64_t root = 0, bit = (uint64_t)1 << 62;
+    while (bit > sq)
+        bit >>= 2;
+    while (bit != 0)
+    {
+        if (sq >= root + bit)
+        {
+            sq -= root + bit;
+            root = (root >> 1) + bit;
+        }
+        else
+        {
+            root >>= 1;
+        }
+        bit >>= 2;
+    }
+    return Fixed::fromRaw((int32_t)root);
+}
+
+#endif // FIXED_POINT_H
@@ -0,0 +1,67 @@
+#include "FrameProfiler.h"
+
+const char *profilePhaseName(ProfilePhase phase)
+{
+    static const char *names[PROFILE_PHASE_COUNT] = {"input", "physics", "collisions", "update", "raster", "flush"};
+    return (phase >= 0 && phase < PROFILE_PHASE_COUNT) ? names[phase] : "?";
+}
+
+#if defined(ASTRO_ENABLE_PROFILER)
+
+#include <algorithm>
+
+FrameProfiler::FrameProfiler()
+{
+    reset();
+}
+
+void FrameProfiler::reset()
+{
+    memset(rings, 0, sizeof(rings));
+}
+
+void FrameProfiler::reset(ProfilePhase phase)
+{
+    memset(&rings[phase], 0, sizeof(rings[phase]));
+}
+
+uint32_t FrameProfiler::ticksToNs(uint32_t ticks)
+{
+#if defined(ESP32)
+    return (uint32_t)((uint64_t)ticks * 1000 / getCpuFrequencyMhz());
+#elif defined(ASTRO_HOST_BUILD)
+    return ticks;
+#else
+    return ticks * 1000; // micros()
+#endif
+}
+
+// Sorts a copy of the ring: called on demand, never per frame
+void FrameProfiler::stats(ProfilePhase phase, ProfileStats &out) const
+{
+    memset(&out, 0, sizeof(out));
+    const PhaseRing &ring = rings[phase];
+    int n = (ring.next < (uint32_t)PROFILER_SAMPLES) ? (int)ring.next : PROFILER_SAMPLES;
+    if (n == 0)
+        return;
+
+    uint32_t ns[PROFILER_SAMPLES];
+    uint64_t sum = 0;
+    for (int i = 0; i < n; ++i)
+    {
+        ns[i] = ticksToNs(ring.ticks[i]);
+        sum += ns[i];
+        int bucket = 0;
+        while (bucket < PROFILER_HISTOGRAM_BUCKETS - 1 && ns[i] >= (1u << (bucket + PROFILER_HISTOGRAM_SHIFT)))
+            bucket++;
+        out.histogram[bucket]++;
+    }
+    std::sort(ns, ns + n);
+    out.samples = n;
+    out.minNs = ns[0];
+    out.maxNs = ns[n - 1];
+    out.meanNs = (uint32_t)(sum / n);
+    out.p99Ns = ns[(n * 99 + 99) / 100 - 1]; // Nearest rank
+}
+
+#endif // ASTRO_ENABLE_PROFILER
@@ -0,0 +1,105 @@
+#ifndef FRAME_PROFILER_H
+#define FRAME_PROFILER_H
+
+#include <Arduino.h>
+
+// --- Frame Profiler ---
+// Build with ASTRO_ENABLE_PROFILER defined to time the phases of every
+// frame: the CPU cycle counter on ESP32, steady_clock on the host. Each
+// phase keeps its last PROFILER_SAMPLES timings in a fixed ring; statistics
+// are computed only when asked for. Without the define, ASTRO_PROFILE()
+// expands to nothing and no profiler state exists.
+
+enum ProfilePhase {
+    PROFILE_INPUT,      // handleInput()
+    PROFILE_PHYSICS,    // updateGameObjects()
+    PROFILE_COLLISIONS, // handleCollisions()
+    PROFILE_UPDATE,     // All of update() or replayFrame()
+    PROFILE_RASTER,     // Drawing a snapshot into the framebuffer (render side from here)
+    PROFILE_FLUSH,      // Sending it to the panel
+    PROFILE_PHASE_COUNT
+};
+
+const int PROFILER_SAMPLES = 256; // Per phase; power of two
+const int PROFILER_HISTOGRAM_BUCKETS = 16; // Doubling ns buckets
+const int PROFILER_HISTOGRAM_SHIFT = 7;    // First bucket: below 2^7 = 128 ns
+
+struct ProfileStats {
+    uint16_t samples; // In the ring (at most PROFILER_SAMPLES)
+    uint32_t minNs;
+    uint32_t meanNs;
+    uint32_t p99Ns;
+    uint32_t maxNs;
+    uint16_t histogram[PROFILER_HISTOGRAM_BUCKETS]; // Bucket b: below 2^(b + 7) ns; the last is open-ended
+};
+
+const char *profilePhaseName(ProfilePhase phase);
+
+#if defined(ASTRO_ENABLE_PROFILER)
+
+#if defined(ASTRO_HOST_BUILD)
+#include <chrono>
+#endif
+
+class FrameProfiler {
+public:
+    FrameProfiler();
+
+    // Raw timestamps: CPU cycles on ESP32, ns on the host
+    static uint32_t now()
+    {
+#if defined(ESP32)
+        return ESP.getCycleCount();
+#elif defined(ASTRO_HOST_BUILD)
+        return (uint32_t)std::chrono::duration_cast<std::chrono::nanoseconds>(
+                   std::chrono::steady_clock::now().time_since_epoch()).count();
+#else
+        return micros();
+#endif
+    }
+
+    void record(ProfilePhase phase, uint32_t start, uint32_t end)
+    {
+        PhaseRing &ring = rings[phase];
+        ring.ticks[ring.next & (PROFILER_SAMPLES - 1)] = end - start; // Wraps correctly
+        ring.next++;
+    }
+
+    void stats(ProfilePhase phase, ProfileStats &out) const;
+    void reset();
+    void reset(ProfilePhase phase);
+
+private:
+    struct PhaseRing {
+        uint32_t ticks[PROFILER_SAMPLES];
+        uint32_t next; // Total recorded; the ring holds the newest
+    };
+    PhaseRing rings[PROFILE_PHASE_COUNT];
+
+    static uint32_t ticksToNs(uint32_t ticks);
+};
+
+// Times the rest of the enclosing scope as `phase`
+class ProfileScope {
+public:
+    ProfileScope(FrameProfiler &profiler, ProfilePhase phase)
+        : profiler(profiler), phase(phase), start(FrameProfiler::now()) {}
+    ~ProfileScope() { profiler.record(phase, start, FrameProfiler::now()); }
+
+private:
+    FrameProfiler &profiler;
+    ProfilePhase phase;
+    uint32_t start;
+};
+
+#define ASTRO_PROFILE_CONCAT2(a, b) a##b
+#define ASTRO_PROFILE_CONCAT(a, b) ASTRO_PROFILE_CONCAT2(a, b)
+#define ASTRO_PROFILE(profiler, phase) ProfileScope ASTRO_PROFILE_CONCAT(profileScope, __LINE__)(profiler, phase)
+
+#else
+
+#define ASTRO_PROFILE(profiler, phase) ((void)0)
+
+#endif // ASTRO_ENABLE_PROFILER
+
+#endif // FRAME_PROFILER_H
@@ -0,0 +1,325 @@
+#ifndef FRAME_RASTER_H
+#define FRAME_RASTER_H
+
+#include <Arduino.h>
+#include "GameData.h"
+
+// Draws white pixels straight into an SSD1306 page-layout framebuffer
+// (byte = 8 vertical pixels, Width bytes per page). Skips the
+// Adafruit_GFX virtual drawPixel per pixel; lines walk a byte pointer and
+// bit mask instead. Line pixels match Adafruit_GFX::drawLine exactly.
+// The panel size is a template parameter so strides and clip bounds are
+// constants; FrameRaster is the default 128x64 panel.
+template <int Width = SCREEN_WIDTH, int Height = SCREEN_HEIGHT>
+class BasicFrameRaster {
+public:
+    static const int PAGES = Height / 8;
+
+    BasicFrameRaster();
+    void setBuffer(uint8_t *framebuffer) { buffer = framebuffer; }
+
+    // --- Clipped primitives ---
+    void pixel(int x, int y);
+    void vspan(int x, int y0, int y1); // Byte-at-a-time vertical run
+    void hspan(int x0, int x1, int y);
+    void line(int x0, int y0, int x1, int y1);
+    void triangle(int x0, int y0, int x1, int y1, int x2, int y2);
+    // 8-pixel-tall bitmap, one byte per column (bit 0 on top), ORed in at
+    // (x, y): two byte writes per column whatever the row alignment
+    void columns(int x, int y, const uint8_t *bits, int width);
+
+    // --- Toroidal primitives ---
+    // Anything hanging off one edge is also drawn entering from the opposite edge.
+    void pixelWrapped(int x, int y);
+    void lineWrapped(int x0, int y0, int x1, int y1);
+    void triangleWrapped(int x0, int y0, int x1, int y1, int x2, int y2);
+
+private:
+    uint8_t *buffer;
+
+    void lineUnclipped(int x0, int y0, int x1, int y1);
+    void lineClipped(int x0, int y0, int x1, int y1);
+
+    static_assert(Height % 8 == 0, "SSD1306 pages are 8 rows tall");
+};
+
+typedef BasicFrameRaster<> FrameRaster;
+
+template <int Width, int Height>
+BasicFrameRaster<Width, Height>::BasicFrameRaster() : buffer(NULL) {}
+
+// --- Clipped Primitives ---
+
+template <int Width, int Height>
+void BasicFrameRaster<Width, Height>::pixel(int x, int y)
+{
+    if ((unsigned)x < (unsigned)Width && (unsigned)y < (unsigned)Height)
+        buffer[x + (y >> 3) * Width] |= (uint8_t)(1 << (y & 7));
+}
+
+template <int Width, int Height>
+void BasicFrameRaster<Width, Height>::vspan(int x, int y0, int y1)
+{
+    if (y0 > y1)
+    {
+        int tmp = y0;
+        y0 = y1;
+        y1 = tmp;
+    }
+    if ((unsigned)x >= (unsigned)Width || y1 < 0 || y0 >= Height)
+        return;
+    if (y0 < 0)
+        y0 = 0;
+    if (y1 >= Height)
+        y1 = Height - 1;
+
+    uint8_t *p = buffer + x + (y0 >> 3) * Width;
+    uint8_t *last = buffer + x + (y1 >> 3) * Width;
+    uint8_t headMask = (uint8_t)(0xFF << (y0 & 7));
+    uint8_t tailMask = (uint8_t)(0xFF >> (7 - (y1 & 7)));
+    if (p == last)
+    {
+        *p |= headMask & tailMask; // Span inside one page
+        return;
+    }
+    *p |= headMask;
+    for (p += Width; p < last; p += Width)
+        *p = 0xFF; // Whole byte: 8 pixels at once
+    *p |= tailMask;
+}
+
+template <int Width, int Height>
+void BasicFrameRaster<Width, Height>::hspan(int x0, int x1, int y)
+{
+    if (x0 > x1)
+    {
+        int tmp = x0;
+        x0 = x1;
+        x1 = tmp;
+    }
+    if ((unsigned)y >= (unsigned)Height || x1 < 0 || x0 >= Width)
+        return;
+    if (x0 < 0)
+        x0 = 0;
+    if (x1 >= Width)
+        x1 = Width - 1;
+
+    uint8_t *p = buffer + x0 + (y >> 3) * Width;
+    uint8_t mask = (uint8_t)(1 << (y & 7));
+    for (int n = x1 - x0; n >= 0; --n)
+        *p++ |= mask;
+}
+
+template <int Width, int Height>
+void BasicFrameRaster<Width, Height>::columns(int x, int y, const uint8_t *bits, int width)
+{
+    if (y <= -8 || y >= Height)
+        return;
+    int page = y >> 3; // Floor, also for negative y
+    int shift = y & 7;
+    uint8_t *upper = (page >= 0) ? buffer + page * Width : NULL;
+    uint8_t *lower = (shift && page + 1 < PAGES) ? buffer + (page + 1) * Width : NULL;
+    for (int i = 0; i < width; ++i)
+    {
+        int cx = x + i;
+        if ((unsigned)cx >= (unsigned)Width)
+            continue;
+        if (upper)
+            upper[cx] |= (uint8_t)(bits[i] << shift);
+        if (lower)
+            lower[cx] |= (uint8_t)(bits[i] >> (8 - shift));
+    }
+}
+
+template <int Width, int Height>
+void BasicFrameRaster<Width, Height>::line(int x0, int y0, int x1, int y1)
+{
+    if (x0 == x1)
+    {
+        vspan(x0, y0, y1);
+        return;
+    }
+    if (y0 == y1)
+    {
+        hspan(x0, x1, y0);
+        return;
+    }
+
+    bool inside = (unsigned)x0 < (unsigned)Width && (unsigned)x1 < (unsigned)Width &&
+                  (unsigned)y0 < (unsigned)Height && (unsigned)y1 < (unsigned)Height;
+    if (inside)
+    {
+        lineUnclipped(x0, y0, x1, y1);
+        return;
+    }
+    // Trivial reject: both ends beyond the same edge
+    if ((x0 < 0 && x1 < 0) || (x0 >= Width && x1 >= Width) ||
+        (y0 < 0 && y1 < 0) || (y0 >= Height && y1 >= Height))
+        return;
+    lineClipped(x0, y0, x1, y1);
+}
+
+template <int Width, int Height>
+void BasicFrameRaster<Width, Height>::triangle(int x0, int y0, int x1, int y1, int x2, int y2)
+{
+    line(x0, y0, x1, y1);
+    line(x1, y1, x2, y2);
+    line(x2, y2, x0, y0);
+}
+
+// --- Toroidal Primitives ---
+
+template <int Width, int Height>
+void BasicFrameRaster<Width, Height>::pixelWrapped(int x, int y)
+{
+    x %= Width;
+    if (x < 0)
+        x += Width;
+    y %= Height;
+    if (y < 0)
+        y += Height;
+    buffer[x + (y >> 3) * Width] |= (uint8_t)(1 << (y & 7));
+}
+
+template <int Width, int Height>
+void BasicFrameRaster<Width, Height>::lineWrapped(int x0, int y0, int x1, int y1)
+{
+    line(x0, y0, x1, y1);
+
+    // Extra copies shifted by one screen wherever the line hangs off an edge
+    int minX = min(x0, x1), maxX = max(x0, x1);
+    int minY = min(y0, y1), maxY = max(y0, y1);
+    int shiftX = (minX < 0) ? Width : (maxX >= Width) ? -Width : 0;
+    int shiftY = (minY < 0) ? Height : (maxY >= Height) ? -Height : 0;
+    if (shiftX)
+        line(x0 + shiftX, y0, x1 + shiftX, y1);
+    if (shiftY)
+        line(x0, y0 + shiftY, x1, y1 + shiftY);
+    if (shiftX && shiftY)
+        line(x0 + shiftX, y0 + shiftY, x1 + shiftX, y1 + shiftY); // Corner
+}
+
+template <int Width, int Height>
+void BasicFrameRaster<Width, Height>::triangleWrapped(int x0, int y0, int x1, int y1, int x2, int y2)
+{
+    lineWrapped(x0, y0, x1, y1);
+    lineWrapped(x1, y1, x2, y2);
+    lineWrapped(x2, y2, x0, y0);
+}
+
+// --- Line Internals ---
+// Same Bresenham setup as Adafruit_GFX::writeLine (iterate along the major
+// axis from its low end, err starts at half the major delta) so the pixels
+// match the GFX path.
+
+template <int Width, int Height>
+void BasicFrameRaster<Width, Height>::lineUnclipped(int x0, int y0, int x1, int y1)
+{
+    int dx = abs(x1 - x0), dy = abs(y1 - y0);
+    if (dx >= dy)
+    {
+        // Shallow: one column per step, y moves by bit
+        if (x0 > x1)
+        {
+            int t = x0; x0 = x1; x1 = t;
+            t = y0; y0 = y1; y1 = t;
+        }
+        bool down = y1 > y0;
+        uint8_t *p = buffer + x0 + (y0 >> 3) * Width;
+        uint8_t mask = (uint8_t)(1 << (y0 & 7));
+        int err = dx / 2;
+        for (int n = dx; n >= 0; --n)
+        {
+            *p++ |= mask;
+            err -= dy;
+            if (err < 0)
+            {
+                err += dx;
+                if (down)
+                {
+                    mask <<= 1;
+                    if (!mask)
+                    {
+                        mask = 0x01;
+                        p += Width;
+                    }
+                }
+                else
+                {
+                    mask >>= 1;
+                    if (!mask)
+                    {
+                        mask = 0x80;
+                        p -= Width;
+                    }
+                }
+            }
+        }
+    }
+    else
+    {
+        // Steep: one row per step, x moves by byte
+        if (y0 > y1)
+        {
+            int t = x0; x0 = x1; x1 = t;
+            t = y0; y0 = y1; y1 = t;
+        }
+        int xstep = (x1 > x0) ? 1 : -1;
+        uint8_t *p = buffer + x0 + (y0 >> 3) * Width;
+        uint8_t mask = (uint8_t)(1 << (y0 & 7));
+        int err = dy / 2;
+        for (int n = dy; n >= 0; --n)
+        {
+            *p |= mask;
+            mask <<= 1;
+            if (!mask)
+            {
+                mask = 0x01;
+                p += Width;
+            }
+            err -= dx;
+            if (err < 0)
+            {
+                err += dy;
+                p += xstep;
+            }
+        }
+    }
+}
+
+template <int Width, int Height>
+void BasicFrameRaster<Width, Height>::lineClipped(int x0, int y0, int x1, int y1)
+{
+    // Same walk as lineUnclipped, bounds-checked per pixel. Only used for
+    // lines crossing an edge, which are short in this game.
+    int dx = abs(x1 - x0), dy = abs(y1 - y0);
+    bool steep = dy > dx;
+    if (steep)
+    {
+        int t = x0; x0 = y0; y0 = t;
+        t = x1; x1 = y1; y1 = t;
+        t = dx; dx = dy; dy = t;
+    }
+    if (x0 > x1)
+    {
+        int t = x0; x0 = x1; x1 = t;
+        t = y0; y0 = y1; y1 = t;
+    }
+    int ystep = (y0 < y1) ? 1 : -1;
+    int err = dx / 2;
+    for (; x0 <= x1; x0++)
+    {
+        if (steep)
+            pixel(y0, x0);
+        else
+            pixel(x0, y0);
+        err -= dy;
+        if (err < 0)
+        {
+            y0 += ystep;
+            err += dx;
+        }
+    }
+}
+
+#endif // FRAME_RASTER_H
@@ -0,0 +1,76 @@
+#ifndef FRAME_SNAPSHOT_H
+#define FRAME_SNAPSHOT_H
+
+#include <Arduino.h>
+#include <atomic>
+#include "AstroConfig.h"
+
+// Everything draw() needs from one simulated frame. update() fills one at the
+// end of every step; rendering reads only the snapshot, never live game
+// state, so the two can run on different cores.
+template <typename Config>
+struct BasicFrameSnapshot {
+    uint32_t sequence;   // Increments with every published frame
+    uint32_t sceneVersion; // START/GAME_OVER: unchanged means the screen is identical
+    GameState state;
+    unsigned long time;  // Game clock at capture (drives blinking)
+    GameObject ship;
+    bool thrusting;
+    int score;
+    int highScore;
+    int lives;
+
+    // Live objects packed in slot order, already rounded to pixels
+    uint16_t bulletCount;
+    int16_t bulletX[Config::MAX_BULLETS];
+    int16_t bulletY[Config::MAX_BULLETS];
+    uint16_t asteroidCount;
+    int16_t asteroidX[Config::MAX_ASTEROIDS];
+    int16_t asteroidY[Config::MAX_ASTEROIDS];
+    int8_t asteroidSize[Config::MAX_ASTEROIDS];
+    AsteroidMesh asteroidMesh[Config::MAX_ASTEROIDS];
+    uint16_t particleCount;
+    uint8_t particleX[Config::PARTICLE_CAPACITY];
+    uint8_t particleY[Config::PARTICLE_CAPACITY];
+};
+
+typedef BasicFrameSnapshot<DefaultConfig> FrameSnapshot;
+
+// Single-producer/single-consumer triple buffer. The writer always has a
+// private slot to fill, the reader always has a private slot to read, and
+// the third slot is swapped between them with one atomic exchange, so
+// neither side ever blocks or sees a half-written value.
+template <typename T>
+class TripleBuffer {
+public:
+    TripleBuffer() : back(0), front(1), middle(2) {}
+
+    // --- Writer ---
+    T &writeSlot() { return slots[back]; }
+    void publish()
+    {
+        back = middle.exchange(back | FRESH, std::memory_order_acq_rel) & INDEX;
+    }
+
+    // --- Reader ---
+    // Takes the newest published value if there is one; false if nothing new
+    bool acquire()
+    {
+        if (!(middle.load(std::memory_order_relaxed) & FRESH))
+            return false;
+        front = middle.exchange(front, std::memory_order_acq_rel) & INDEX;
+        return true;
+    }
+    const T &readSlot() const { return slots[front]; }
+
+private:
+    static const uint8_t INDEX = 0x03;
+    static const uint8_t FRESH = 0x04; // Middle slot holds an unread publish
+
+    T slots[3];
+    uint8_t back;  // Writer only
+    uint8_t front; // Reader only
+    std::atomic<uint8_t> middle;
+};
+
+#endif // FRAME_SNAPSHOT_H
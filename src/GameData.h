@@ -3,30 +3,66 @@
 #define GAME_DATA_H
 
 #include <Arduino.h>
+#include "FixedPoint.h"
+#include "FastTrig.h"
 
 // --- Screen Dimensions ---
 #define SCREEN_WIDTH 128
 #define SCREEN_HEIGHT 64
 
+// --- Time Source ---
+// Millisecond clock used for all game timing. Defaults to Arduino millis(),
+// but can be swapped out (e.g. a simulated clock on the host build).
+typedef unsigned long (*TimeSource)();
+
 // --- Game States ---
-enum GameState { START, GAME, GAME_OVER };
+enum GameState { START, GAME, GAME_OVER, WAVE_CLEAR };
+
+// --- Numeric Mode ---
+// Physics (positions, velocities, radii) uses Scalar. Define ASTRO_FIXED_POINT
+// in the build flags to run it on Q16.16 integers instead of floats.
+#if defined(ASTRO_FIXED_POINT)
+typedef Fixed Scalar;
+#else
+typedef float Scalar;
+#endif
 
 // --- Game Object Structures ---
 struct Vector2D {
-    float x;
-    float y;
+    Scalar x;
+    Scalar y;
 };
 
 struct GameObject {
     Vector2D pos;
     Vector2D vel;
-    float angle;
-    float radius;
+    BAngle angle; // Binary angle, 65536 = full turn
+    Scalar radius;
     bool active; // Ensure this definition is correct
     int lifetime;
     int size;
 };
 
+// --- Asteroid Outline ---
+// Jagged outline built once at spawn time. Vertices are integer offsets from
+// the asteroid centre, so drawing is just translate + drawLine.
+const int MAX_ASTEROID_VERTICES = 8; // 5 + ASTEROID_SIZE_LARGE / 3
+
+struct AsteroidMesh {
+    uint8_t vertexCount;
+    int8_t dx[MAX_ASTEROID_VERTICES];
+    int8_t dy[MAX_ASTEROID_VERTICES];
+};
+
+// --- Simulation Timing ---
+// Physics runs in fixed ticks. Tuning constants below are per reference
+// frame (1/30 s); other tick rates scale them so gameplay speed is the same.
+const int SIM_REFERENCE_RATE = 30;
+const int SIM_TICK_RATE = 30;          // Default ticks per second
+const int MAX_TICKS_PER_UPDATE = 4;    // Beyond this a slow frame drops time instead of catching up
+const int TICK_UNIT = 1000;            // Accumulator units per tick (ms * tick rate)
+const float INTERP_SNAP_DISTANCE = 16; // Moves longer than this in one tick are teleports: no blending
+
 // --- Input Constants ---
 const int JOYSTICK_CENTER = 2048;
 const int JOYSTICK_DEAD_ZONE = 400;
@@ -34,15 +70,16 @@ const int JOYSTICK_MAX_THROW = 2047; // Max deviation from center (4095 - 2048 a
 
 // --- Game Tuning Constants ---
 // ... (Ship Turn/Thrust/Friction, Bullet Speed/Lifetime/Max) ...
-const float SHIP_TURN_SPEED = 0.12;  // Max turn speed
+const BAngle SHIP_TURN_SPEED = radiansToBAngle(0.12); // Max turn speed (~0.12 rad/frame)
+const BAngle SHIP_START_ANGLE = radiansToBAngle(-M_PI / 2); // Pointing up
 const float SHIP_THRUST = 0.20;      // Max thrust acceleration
-const float SHIP_FRICTION = 0.97;
-const float BULLET_SPEED = 3.5;
+const Scalar SHIP_FRICTION = 0.97f; // Scalar: applied every frame
+constexpr float BULLET_SPEED = 3.5;
 const int   BULLET_LIFETIME = 40;
 const int   MAX_BULLETS = 5;
 // ... (Asteroid Speed/Max/Starting/Sizes) ...
-const float ASTEROID_SPEED_MIN = 0.5;
-const float ASTEROID_SPEED_MAX = 1.5;
+constexpr float ASTEROID_SPEED_MIN = 0.5;
+constexpr float ASTEROID_SPEED_MAX = 1.5;
 const int   MAX_ASTEROIDS = 10;
 const int   STARTING_ASTEROIDS = 3;
 const float SHIP_COLLISION_RADIUS = 4.0;
@@ -50,13 +87,26 @@ const float BULLET_COLLISION_RADIUS = 1.0;
 const int   ASTEROID_SIZE_LARGE = 10;
 const int   ASTEROID_SIZE_MEDIUM = 6;
 const int   ASTEROID_SIZE_SMALL = 3;
+const BAngle FRAGMENT_ANGLE_SPREAD = radiansToBAngle(0.25); // +/- spread for split fragments
 // ... (Invincibility, Fire Debounce) ...
 const unsigned long INVINCIBILITY_DURATION = 2000;
 const unsigned long FIRE_DEBOUNCE_DELAY = 150;
+const unsigned long WAVE_CLEAR_DURATION = 1500; // "Wave Cleared!" pause before the next wave
 // --- NEW ---
 const unsigned long HYPERSPACE_COOLDOWN = 5000; // 5 seconds between jumps
 const unsigned long HYPERSPACE_INVINCIBILITY = 750; // Shorter invincibility after jump
 
+// --- Particles ---
+const int   PARTICLE_CAPACITY = 64;            // Ring slots; power of two
+const int   PARTICLE_BUDGET = 48;              // Default cap on particles updated and drawn per tick
+const int   DEBRIS_PER_ASTEROID = 2;           // Debris per unit of asteroid size (large: 20)
+const int   DEBRIS_PER_SHIP = 16;
+const float DEBRIS_SPEED_MIN = 0.4;            // Pixels per reference frame
+const float DEBRIS_SPEED_MAX = 1.6;
+const unsigned long DEBRIS_LIFETIME = 600;     // ms; each particle lives 50-100% of this
+const float EXHAUST_SPEED = 1.2;               // Backwards from the ship
+const unsigned long EXHAUST_LIFETIME = 200;
+
 
 // --- Audio Frequencies (Hz) & Durations (ms) ---
 const uint16_t SND_SHOOT_FREQ = 2500;
@@ -66,5 +116,9 @@ const uint16_t SND_THRUST_FREQ_HIGH = 250;
 const uint16_t SND_HYPERSPACE_FREQ = 4000; // NEW
 const uint32_t SND_SHORT_DURATION = 50;
 const uint32_t SND_HYPERSPACE_DURATION = 300; // NEW
+const uint16_t SND_EXPLODE_END_FREQ = 80;      // Explosion sweeps down to this
+const uint16_t SND_HYPERSPACE_END_FREQ = 1000; // Hyperspace sweeps down to this
+const uint16_t SND_SWEEP_STEP = 5;             // ms between frequency changes in a sweep
+const uint32_t SND_SEQUENCER_PERIOD_US = 1000; // Sequencer timer period
 
 #endif // GAME_DATA_H
\ No newline at end of file
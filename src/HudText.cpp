@@ -0,0 +1,78 @@
+#include "HudText.h"
+
+// Classic GFX 5x7 glyphs, one byte per column, bit 0 on top
+struct HudGlyph {
+    char c;
+    uint8_t columns[5];
+};
+
+static const HudGlyph HUD_GLYPHS[] = {
+    {'0', {0x3E, 0x51, 0x49, 0x45, 0x3E}},
+    {'1', {0x00, 0x42, 0x7F, 0x40, 0x00}},
+    {'2', {0x42, 0x61, 0x51, 0x49, 0x46}},
+    {'3', {0x21, 0x41, 0x45, 0x4B, 0x31}},
+    {'4', {0x18, 0x14, 0x12, 0x7F, 0x10}},
+    {'5', {0x27, 0x45, 0x45, 0x45, 0x39}},
+    {'6', {0x3C, 0x4A, 0x49, 0x49, 0x30}},
+    {'7', {0x01, 0x71, 0x09, 0x05, 0x03}},
+    {'8', {0x36, 0x49, 0x49, 0x49, 0x36}},
+    {'9', {0x06, 0x49, 0x49, 0x29, 0x1E}},
+    {'-', {0x08, 0x08, 0x08, 0x08, 0x08}},
+    {':', {0x00, 0x36, 0x36, 0x00, 0x00}},
+    {'H', {0x7F, 0x08, 0x08, 0x08, 0x7F}},
+    {'I', {0x00, 0x41, 0x7F, 0x41, 0x00}},
+};
+static const int HUD_GLYPH_COUNT = sizeof(HUD_GLYPHS) / sizeof(HUD_GLYPHS[0]);
+
+HudText::HudText(const char *label) : label(label ? label : ""), cachedValue(0), valid(false), length(0)
+{
+    memset(bits, 0, sizeof(bits));
+}
+
+bool HudText::setValue(long value)
+{
+    if (valid && value == cachedValue)
+        return false;
+    cachedValue = value;
+    valid = true;
+
+    // Format right to left into a stack buffer: no String, no printf
+    char text[HUD_TEXT_MAX_CHARS + 1];
+    char digits[12];
+    int n = 0;
+    unsigned long magnitude = (value < 0) ? 0UL - (unsigned long)value : (unsigned long)value;
+    do
+    {
+        digits[n++] = '0' + magnitude % 10;
+        magnitude /= 10;
+    } while (magnitude && n < (int)sizeof(digits));
+
+    int len = 0;
+    for (const char *p = label; *p && len < HUD_TEXT_MAX_CHARS; ++p)
+        text[len++] = *p;
+    if (value < 0 && len < HUD_TEXT_MAX_CHARS)
+        text[len++] = '-';
+    while (n > 0 && len < HUD_TEXT_MAX_CHARS)
+        text[len++] = digits[--n];
+    text[len] = '\0';
+    render(text);
+    return true;
+}
+
+void HudText::render(const char *text)
+{
+    length = 0;
+    for (; *text; ++text, ++length)
+    {
+        uint8_t *cell = bits + length * HUD_GLYPH_ADVANCE;
+        memset(cell, 0, HUD_GLYPH_ADVANCE);
+        for (int g = 0; g < HUD_GLYPH_COUNT; ++g)
+        {
+            if (HUD_GLYPHS[g].c == *text)
+            {
+                memcpy(cell, HUD_GLYPHS[g].columns, 5);
+                break;
+            }
+        }
+    }
+}
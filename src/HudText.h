@@ -0,0 +1,36 @@
+#ifndef HUD_TEXT_H
+#define HUD_TEXT_H
+
+#include <Arduino.h>
+
+// --- HUD Text ---
+// A label plus a number ("HI:1250") rendered once into an 8-pixel-tall
+// column bitmap and blitted with FrameRaster::columns() every frame. The
+// bitmap is rebuilt only when the number changes, without allocating.
+// Glyphs are the classic 5x7 GFX font in 6-pixel cells; only digits, '-'
+// and the letters the HUD labels use are included.
+const int HUD_TEXT_MAX_CHARS = 16;
+const int HUD_GLYPH_ADVANCE = 6; // 5 columns + 1 blank, like the GFX font at size 1
+
+class HudText {
+public:
+    explicit HudText(const char *label = "");
+
+    // Rebuilds the bitmap if `value` differs from the cached one; true if it did
+    bool setValue(long value);
+    void invalidate() { valid = false; }
+
+    const uint8_t *columns() const { return bits; }
+    int width() const { return length * HUD_GLYPH_ADVANCE; } // Includes the trailing blank column
+
+private:
+    const char *label;
+    long cachedValue;
+    bool valid;
+    uint8_t length;
+    uint8_t bits[HUD_TEXT_MAX_CHARS * HUD_GLYPH_ADVANCE];
+
+    void render(const char *text);
+};
+
+#endif // HUD_TEXT_H
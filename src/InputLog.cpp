@@ -0,0 +1,236 @@
+#include "InputLog.h"
+#include "GameData.h"
+
+static const uint8_t RUN_FLAG = 0x80;
+static const uint8_t CHANGE_FLAG = 0x40;
+static const uint8_t END_MARKER = 0x00;
+static const uint8_t CHANGED_ELAPSED = 0x01;
+static const uint8_t CHANGED_JOY_X = 0x02;
+static const uint8_t CHANGED_JOY_Y = 0x04;
+static const uint8_t FIRE_DOWN = 0x08;
+static const uint8_t HYPERSPACE_DOWN = 0x10;
+
+// Both sides diff the first frame against this
+static InputFrame initialFrame()
+{
+    InputFrame frame = {0, (int16_t)JOYSTICK_CENTER, (int16_t)JOYSTICK_CENTER, false, false};
+    return frame;
+}
+
+// --- Writer ---
+
+InputLogWriter::InputLogWriter(uint8_t *buffer, size_t capacity)
+    : buffer(buffer), capacity(capacity), length(0), frames(0), overflow(false), last(initialFrame()), pendingRun(0)
+{
+}
+
+void InputLogWriter::begin(const InputLogHeader &header)
+{
+    length = 0;
+    frames = 0;
+    overflow = false;
+    last = initialFrame();
+    pendingRun = 0;
+
+    putByte('A');
+    putByte('I');
+    putByte('L');
+    putByte(INPUT_LOG_VERSION);
+    putU32(header.seed);
+    putByte(header.tickRate & 0xFF);
+    putByte(header.tickRate >> 8);
+    putU32((uint32_t)header.highScore);
+}
+
+void InputLogWriter::append(const InputFrame &frame)
+{
+    if (overflow)
+        return;
+    frames++;
+    if (frame == last)
+    {
+        if (++pendingRun == INPUT_LOG_MAX_RUN)
+            flushRun();
+        return;
+    }
+    flushRun();
+
+    uint8_t control = CHANGE_FLAG;
+    if (frame.elapsedMs != last.elapsedMs)
+        control |= CHANGED_ELAPSED;
+    if (frame.joyX != last.joyX)
+        control |= CHANGED_JOY_X;
+    if (frame.joyY != last.joyY)
+        control |= CHANGED_JOY_Y;
+    if (frame.fire)
+        control |= FIRE_DOWN;
+    if (frame.hyperspace)
+        control |= HYPERSPACE_DOWN;
+    putByte(control);
+    if (control & CHANGED_ELAPSED)
+        putVarint((int32_t)frame.elapsedMs - last.elapsedMs);
+    if (control & CHANGED_JOY_X)
+        putVarint(frame.joyX - last.joyX);
+    if (control & CHANGED_JOY_Y)
+        putVarint(frame.joyY - last.joyY);
+    last = frame;
+}
+
+void InputLogWriter::finish(uint32_t checksum)
+{
+    flushRun();
+    putByte(END_MARKER);
+    putU32(checksum);
+}
+
+void InputLogWriter::flushRun()
+{
+    if (pendingRun > 0)
+    {
+        putByte(RUN_FLAG | (pendingRun - 1));
+        pendingRun = 0;
+    }
+}
+
+void InputLogWriter::putByte(uint8_t value)
+{
+    if (length < capacity)
+        buffer[length++] = value;
+    else
+        overflow = true;
+}
+
+void InputLogWriter::putVarint(int32_t value)
+{
+    uint32_t zigzag = ((uint32_t)value << 1) ^ (uint32_t)(value >> 31);
+    while (zigzag >= 0x80)
+    {
+        putByte((uint8_t)(zigzag | 0x80));
+        zigzag >>= 7;
+    }
+    putByte((uint8_t)zigzag);
+}
+
+void InputLogWriter::putU32(uint32_t value)
+{
+    for (int i = 0; i < 4; ++i)
+        putByte((uint8_t)(value >> (8 * i)));
+}
+
+// --- Reader ---
+
+InputLogReader::InputLogReader(const uint8_t *data, size_t size)
+    : data(data), size(size), pos(0), last(initialFrame()), pendingRun(0), ended(false), damaged(false), finalChecksum(0)
+{
+}
+
+bool InputLogReader::readHeader(InputLogHeader &header)
+{
+    pos = 0;
+    last = initialFrame();
+    pendingRun = 0;
+    ended = false;
+    damaged = false;
+    if (size < (size_t)INPUT_LOG_HEADER_SIZE || data[0] != 'A' || data[1] != 'I' || data[2] != 'L' ||
+        data[3] != INPUT_LOG_VERSION)
+        return false;
+    pos = 4;
+    uint32_t highScore;
+    uint8_t lo, hi;
+    getU32(header.seed);
+    getByte(lo);
+    getByte(hi);
+    getU32(highScore);
+    header.tickRate = lo | (hi << 8);
+    header.highScore = (int32_t)highScore;
+    return true;
+}
+
+bool InputLogReader::next(InputFrame &frame)
+{
+    if (ended || damaged)
+        return false;
+    if (pendingRun > 0)
+    {
+        pendingRun--;
+        frame = last;
+        return true;
+    }
+
+    uint8_t control;
+    if (!getByte(control))
+    {
+        damaged = true; // Truncated: no end marker
+        return false;
+    }
+    if (control == END_MARKER)
+    {
+        ended = getU32(finalChecksum);
+        return false;
+    }
+    if (control & RUN_FLAG)
+    {
+        pendingRun = control & 0x7F; // This call returns the first repeat
+        frame = last;
+        return true;
+    }
+
+    InputFrame decoded = last;
+    int32_t delta;
+    if ((control & CHANGED_ELAPSED) && getVarint(delta))
+        decoded.elapsedMs = (uint16_t)(last.elapsedMs + delta);
+    if ((control & CHANGED_JOY_X) && getVarint(delta))
+        decoded.joyX = (int16_t)(last.joyX + delta);
+    if ((control & CHANGED_JOY_Y) && getVarint(delta))
+        decoded.joyY = (int16_t)(last.joyY + delta);
+    decoded.fire = (control & FIRE_DOWN) != 0;
+    decoded.hyperspace = (control & HYPERSPACE_DOWN) != 0;
+    if (damaged)
+        return false;
+    last = decoded;
+    frame = decoded;
+    return true;
+}
+
+bool InputLogReader::getByte(uint8_t &value)
+{
+    if (pos >= size)
+    {
+        damaged = true;
+        return false;
+    }
+    value = data[pos++];
+    return true;
+}
+
+bool InputLogReader::getVarint(int32_t &value)
+{
+    uint32_t zigzag = 0;
+    for (int shift = 0; shift < 35; shift += 7)
+    {
+        uint8_t b;
+        if (!getByte(b))
+            return false;
+        zigzag |= (uint32_t)(b & 0x7F) << shift;
+        if (!(b & 0x80))
+        {
+            value = (int32_t)(zigzag >> 1) ^ -(int32_t)(zigzag & 1);
+            return true;
+        }
+    }
+    damaged = true;
+    return false;
+}
+
+bool InputLogReader::getU32(uint32_t &value)
+{
+    value = 0;
+    for (int i = 0; i < 4; ++i)
+    {
+        uint8_t b;
+        if (!getByte(b))
+            return false;
+        value |= (uint32_t)b << (8 * i);
+    }
+    return true;
+}
@@ -0,0 +1,98 @@
+#ifndef INPUT_LOG_H
+#define INPUT_LOG_H
+
+#include <Arduino.h>
+
+// --- Recorded Session Format ---
+// A session is everything needed to replay a game bit-exactly: the seed and
+// settings it started from, then one InputFrame per update() call.
+//
+//   header  "AIL" version(1)  seed:u32  tickRate:u16  highScore:i32   (little endian)
+//   frames  0x80 | (n - 1)            repeat the previous frame n times (1..128)
+//           0x40 | mask, varints...   changed frame: mask bit 0/1/2 = elapsed/joyX/joyY
+//                                     follow as zigzag varint deltas; bit 3/4 = fire/hyperspace level
+//   end     0x00  checksum:u32        stateChecksum() after the last frame
+//
+// Held sticks and steady frame pacing collapse into runs, and ADC jitter
+// costs one byte per changed axis.
+
+const uint8_t INPUT_LOG_VERSION = 1;
+const int INPUT_LOG_HEADER_SIZE = 14;
+const int INPUT_LOG_MAX_RUN = 128;
+
+struct InputFrame {
+    uint16_t elapsedMs; // Real time since the previous update()
+    int16_t joyX;
+    int16_t joyY;
+    bool fire;          // Joystick or digital fire button
+    bool hyperspace;
+
+    bool operator==(const InputFrame &other) const
+    {
+        return elapsedMs == other.elapsedMs && joyX == other.joyX && joyY == other.joyY &&
+               fire == other.fire && hyperspace == other.hyperspace;
+    }
+    bool operator!=(const InputFrame &other) const { return !(*this == other); }
+};
+
+struct InputLogHeader {
+    uint32_t seed;
+    uint16_t tickRate;
+    int32_t highScore;
+};
+
+// Encodes into a caller-owned buffer (no allocation, so it runs on device).
+// Once the buffer is full further frames are dropped and overflowed() is set.
+class InputLogWriter {
+public:
+    InputLogWriter(uint8_t *buffer, size_t capacity);
+
+    void begin(const InputLogHeader &header);
+    void append(const InputFrame &frame);
+    void finish(uint32_t checksum);
+
+    const uint8_t *data() const { return buffer; }
+    size_t size() const { return length; }
+    uint32_t frameCount() const { return frames; }
+    bool overflowed() const { return overflow; }
+
+private:
+    uint8_t *buffer;
+    size_t capacity;
+    size_t length;
+    uint32_t frames;
+    bool overflow;
+    InputFrame last;
+    int pendingRun; // Repeats of `last` not yet written
+
+    void flushRun();
+    void putByte(uint8_t value);
+    void putVarint(int32_t value); // Zigzag
+    void putU32(uint32_t value);
+};
+
+class InputLogReader {
+public:
+    InputLogReader(const uint8_t *data, size_t size);
+
+    bool readHeader(InputLogHeader &header); // False if not a session log
+    bool next(InputFrame &frame);            // False at the end marker or on damage
+    bool hasChecksum() const { return ended; }
+    uint32_t checksum() const { return finalChecksum; }
+
+private:
+    const uint8_t *data;
+    size_t size;
+    size_t pos;
+    InputFrame last;
+    int pendingRun;
+    bool ended;
+    bool damaged;
+    uint32_t finalChecksum;
+
+    bool getByte(uint8_t &value);
+    bool getVarint(int32_t &value);
+    bool getU32(uint32_t &value);
+};
+
+#endif // INPUT_LOG_H
@@ -0,0 +1,144 @@
+#include "Leaderboard.h"
+
+static const char *LEADERBOARD_KEYS[2] = {"lbA", "lbB"};
+
+Leaderboard::Leaderboard() : prefs(NULL), dirty(false), dirtySince(0), nextSlot(0)
+{
+    memset(&table, 0, sizeof(table));
+    table.magic = LEADERBOARD_MAGIC;
+    table.version = LEADERBOARD_VERSION;
+}
+
+void Leaderboard::begin(Preferences &store, int32_t legacyHighScore)
+{
+    prefs = &store;
+    LeaderboardRecord slots[2];
+    bool valid[2];
+    for (int s = 0; s < 2; ++s)
+        valid[s] = readSlot(store, s, slots[s]);
+
+    if (valid[0] || valid[1])
+    {
+        int newest = (valid[0] && (!valid[1] || (int32_t)(slots[0].generation - slots[1].generation) > 0)) ? 0 : 1;
+        table = slots[newest];
+        nextSlot = 1 - newest;
+        dirty = false;
+        return;
+    }
+
+    // Nothing usable stored yet: carry the old single high score over
+    memset(table.scores, 0, sizeof(table.scores));
+    table.count = 0;
+    table.generation = 0;
+    nextSlot = 0;
+    dirty = false;
+    if (legacyHighScore > 0)
+        submit(legacyHighScore, 0);
+}
+
+bool Leaderboard::submit(int32_t score, unsigned long now)
+{
+    if (score <= 0)
+        return false;
+    int rank = table.count;
+    while (rank > 0 && table.scores[rank - 1] < score)
+        rank--;
+    if (rank >= LEADERBOARD_SIZE)
+        return false;
+    int last = (table.count < LEADERBOARD_SIZE) ? table.count : LEADERBOARD_SIZE - 1;
+    for (int i = last; i > rank; --i)
+        table.scores[i] = table.scores[i - 1];
+    table.scores[rank] = score;
+    if (table.count < LEADERBOARD_SIZE)
+        table.count++;
+    markDirty(now);
+    return true;
+}
+
+void Leaderboard::clear(unsigned long now)
+{
+    memset(table.scores, 0, sizeof(table.scores));
+    table.count = 0;
+    markDirty(now);
+}
+
+void Leaderboard::markDirty(unsigned long now)
+{
+    if (!dirty)
+        dirtySince = now; // Later changes ride along with the first
+    dirty = true;
+}
+
+bool Leaderboard::commitIfDue(unsigned long now)
+{
+    if (!isDue(now))
+        return false;
+    return commit(now);
+}
+
+bool Leaderboard::commit(unsigned long now)
+{
+    LeaderboardRecord record;
+    uint8_t slot;
+    if (!stage(record, slot))
+        return false;
+    bool written = writeStaged(*prefs, slot, record);
+    finishStaged(written, now);
+    return written;
+}
+
+bool Leaderboard::stage(LeaderboardRecord &out, uint8_t &slot)
+{
+    if (!dirty || !prefs)
+        return false;
+    table.magic = LEADERBOARD_MAGIC;
+    table.version = LEADERBOARD_VERSION;
+    table.reserved = 0;
+    table.generation++;
+    table.crc = crc32((const uint8_t *)&table, offsetof(LeaderboardRecord, crc));
+    out = table;
+    slot = nextSlot;
+    dirty = false; // A submit() while the write is in flight makes it dirty again
+    return true;
+}
+
+bool Leaderboard::writeStaged(Preferences &store, uint8_t slot, const LeaderboardRecord &record)
+{
+    return store.putBytes(LEADERBOARD_KEYS[slot], &record, sizeof(record)) == sizeof(record);
+}
+
+void Leaderboard::finishStaged(bool written, unsigned long now)
+{
+    if (written)
+    {
+        nextSlot = 1 - nextSlot;
+        return;
+    }
+    // Retry once the delay has passed again; the skipped generation number is harmless
+    dirty = true;
+    dirtySince = now;
+}
+
+bool Leaderboard::readSlot(Preferences &store, int slot, LeaderboardRecord &out)
+{
+    if (store.getBytesLength(LEADERBOARD_KEYS[slot]) != sizeof(out))
+        return false;
+    if (store.getBytes(LEADERBOARD_KEYS[slot], &out, sizeof(out)) != sizeof(out))
+        return false;
+    return out.magic == LEADERBOARD_MAGIC && out.version == LEADERBOARD_VERSION &&
+           out.count <= LEADERBOARD_SIZE &&
+           out.crc == crc32((const uint8_t *)&out, offsetof(LeaderboardRecord, crc));
+}
+
+// CRC-32 (IEEE), bitwise: the record is 32 bytes and written rarely
+uint32_t Leaderboard::crc32(const uint8_t *data, size_t length)
+{
+    uint32_t crc = 0xFFFFFFFFu;
+    for (size_t i = 0; i < length; ++i)
+    {
+        crc ^= data[i];
+        for (int b = 0; b < 8; ++b)
+            crc = (crc >> 1) ^ (0xEDB88320u & (0u - (crc & 1)));
+    }
+    return ~crc;
+}
@@ -0,0 +1,78 @@
+#ifndef LEADERBOARD_H
+#define LEADERBOARD_H
+
+#include <Arduino.h>
+#include <Preferences.h>
+
+// --- Leaderboard ---
+// Top LEADERBOARD_SIZE scores kept in RAM and persisted as one small
+// versioned, CRC-protected record. Submitting a score never touches flash:
+// changes are coalesced and written by commitIfDue() once they have sat
+// for LEADERBOARD_COMMIT_DELAY, or by commit().
+//
+// Records alternate between two NVS keys (an A/B journal), each carrying
+// a generation number. A commit overwrites the older slot only, so losing
+// power mid-write leaves the previous record intact; loading picks the
+// newest slot whose CRC checks out.
+const int LEADERBOARD_SIZE = 5;
+const uint8_t LEADERBOARD_MAGIC = 'L';
+const uint8_t LEADERBOARD_VERSION = 1;
+const unsigned long LEADERBOARD_COMMIT_DELAY = 3000; // ms a change waits for more before it is written
+
+struct LeaderboardRecord {
+    uint8_t magic;
+    uint8_t version;
+    uint8_t count;                    // Valid entries in scores
+    uint8_t reserved;
+    uint32_t generation;              // Higher is newer
+    int32_t scores[LEADERBOARD_SIZE]; // Descending
+    uint32_t crc;                     // CRC-32 of every byte before it
+};
+
+class Leaderboard {
+public:
+    Leaderboard();
+
+    // Loads the newest valid record. With none, starts from
+    // `legacyHighScore` (the old single-score key) and commits it later.
+    void begin(Preferences &prefs, int32_t legacyHighScore = 0);
+
+    // RAM only. True if the score made the table.
+    bool submit(int32_t score, unsigned long now);
+    void clear(unsigned long now);
+
+    bool commitIfDue(unsigned long now); // True if it wrote
+    bool commit(unsigned long now);      // Writes now if anything changed
+    bool isDirty() const { return dirty; }
+    bool isDue(unsigned long now) const { return dirty && now - dirtySince >= LEADERBOARD_COMMIT_DELAY; }
+
+    // --- Writing From Another Thread ---
+    // commit() split in three, so the flash write can run elsewhere:
+    // stage() seals the pending change into `out` (false if there is none),
+    // writeStaged() stores it and may run on any thread, and finishStaged()
+    // reports the result back. A failed write leaves the change pending,
+    // due again a full LEADERBOARD_COMMIT_DELAY after `now`, so a full or
+    // worn partition is not retried every frame. Only one record may be
+    // staged at a time.
+    bool stage(LeaderboardRecord &out, uint8_t &slot);
+    static bool writeStaged(Preferences &prefs, uint8_t slot, const LeaderboardRecord &record);
+    void finishStaged(bool written, unsigned long now);
+
+    int count() const { return table.count; }
+    int32_t score(int rank) const { return (rank >= 0 && rank < table.count) ? table.scores[rank] : 0; }
+    int32_t best() const { return score(0); }
+    uint32_t generation() const { return table.generation; }
+
+private:
+    Preferences *prefs;
+    LeaderboardRecord table;
+    bool dirty;
+    unsigned long dirtySince;
+    uint8_t nextSlot; // Journal slot the next commit overwrites: the older one
+
+    void markDirty(unsigned long now);
+    static bool readSlot(Preferences &prefs, int slot, LeaderboardRecord &out);
+    static uint32_t crc32(const uint8_t *data, size_t length);
+};
+
+#endif // LEADERBOARD_H
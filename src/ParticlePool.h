@@ -0,0 +1,106 @@
+#ifndef PARTICLE_POOL_H
+#define PARTICLE_POOL_H
+
+#include <Arduino.h>
+#include "GameData.h"
+
+// Fixed-capacity ring of short-lived cosmetic particles (debris, exhaust)
+// stored as structure-of-arrays. Positions and velocities are Q8.8 pixels,
+// so moving and wrapping a particle is two adds and two masks whatever
+// Scalar is.
+//
+// Particles are spawned at the head of the ring in O(1). Only the newest
+// `budget` slots (the window) are ever updated or drawn: spawning into a
+// full window retires the oldest particle, so a chain of explosions costs
+// no more per tick than a full window and the oldest debris simply fades
+// first. Dead particles inside the window are skipped by drawing, not
+// removed; the tail advances past them as they reach it.
+//
+// Iterate the window with:
+//     for (uint32_t n = pool.windowStart(); n != pool.windowEnd(); ++n)
+//         int i = pool.slot(n); ... if (pool.life[i]) ...
+template <int Capacity, int Width = SCREEN_WIDTH, int Height = SCREEN_HEIGHT>
+class ParticlePool {
+public:
+    static const int CAPACITY = Capacity;
+    static const uint32_t MASK = Capacity - 1;
+    static const uint16_t X_MASK = Width * 256 - 1;  // Q8.8 wraparound
+    static const uint16_t Y_MASK = Height * 256 - 1;
+
+    // --- Per-slot data ---
+    uint16_t posX[Capacity]; // Q8.8 pixels, always on screen
+    uint16_t posY[Capacity];
+    int16_t velX[Capacity];  // Q8.8 pixels per tick
+    int16_t velY[Capacity];
+    uint8_t life[Capacity];  // Ticks left; 0 = dead
+
+    ParticlePool() : budget(Capacity), dropped(0) { clear(); }
+
+    void clear()
+    {
+        head = 0;
+        tail = 0;
+    }
+
+    // Caps the window (particles updated and drawn per tick); 1..Capacity
+    void setBudget(int perTick)
+    {
+        budget = (perTick < 1) ? 1 : (perTick > Capacity) ? Capacity : perTick;
+        while (head - tail > (uint32_t)budget)
+            retireOldest();
+    }
+    int getBudget() const { return budget; }
+
+    void spawn(uint16_t x, uint16_t y, int16_t vx, int16_t vy, uint8_t ticks)
+    {
+        if (head - tail >= (uint32_t)budget)
+            retireOldest();
+        int i = head++ & MASK;
+        posX[i] = x & X_MASK;
+        posY[i] = y & Y_MASK;
+        velX[i] = vx;
+        velY[i] = vy;
+        life[i] = ticks;
+    }
+
+    // One tick for every particle in the window: no per-particle branches
+    void update()
+    {
+        for (uint32_t n = tail; n != head; ++n)
+        {
+            int i = n & MASK;
+            posX[i] = (posX[i] + velX[i]) & X_MASK;
+            posY[i] = (posY[i] + velY[i]) & Y_MASK;
+            life[i] -= (life[i] != 0);
+        }
+        while (tail != head && life[tail & MASK] == 0)
+            tail++;
+    }
+
+    uint32_t windowStart() const { return tail; }
+    uint32_t windowEnd() const { return head; }
+    int slot(uint32_t n) const { return n & MASK; }
+    int windowSize() const { return head - tail; }
+    bool empty() const { return head == tail; }
+    uint32_t droppedCount() const { return dropped; } // Retired early by the budget
+
+private:
+    uint32_t head; // Next spawn (free-running; slot = head & MASK)
+    uint32_t tail; // Oldest particle still in the window
+    int budget;
+    uint32_t dropped;
+
+    void retireOldest()
+    {
+        dropped += (life[tail & MASK] != 0);
+        life[tail & MASK] = 0;
+        tail++;
+    }
+
+    static_assert((Capacity & (Capacity - 1)) == 0, "ParticlePool capacity must be a power of two");
+    static_assert((Width & (Width - 1)) == 0 && (Height & (Height - 1)) == 0,
+                  "Particle wraparound masks need power-of-two screen sizes");
+    static_assert(Width * 256 <= 65536 && Height * 256 <= 65536, "Q8.8 positions must fit 16 bits");
+};
+
+#endif // PARTICLE_POOL_H
@@ -0,0 +1,193 @@
+#include "PcmSynth.h"
+#include "FastTrig.h"
+
+// Voices are summed at full scale and then halved, so two loud voices
+// reach full scale and more are clipped rather than wrapped
+const int SYNTH_MIX_SHIFT = 1;
+
+static uint32_t phaseIncrement(uint32_t freq)
+{
+    return (uint32_t)(((uint64_t)freq << 32) / SYNTH_SAMPLE_RATE);
+}
+
+PcmSynth::PcmSynth() : blocksWritten(0), blocksRead(0), queueHead(0), queueTail(0)
+{
+    memset(oscillators, 0, sizeof(oscillators));
+    memset(ring, 0, sizeof(ring));
+    for (int v = 0; v < SYNTH_VOICES; ++v)
+        oscillators[v].noiseState = 0xACE1u + v; // Any nonzero LFSR seed
+}
+
+// --- Producer ---
+
+void PcmSynth::noteOn(int voice, const SynthPatch &patch)
+{
+    if (voice < 0 || voice >= SYNTH_VOICES)
+        return;
+    Command cmd = {(uint8_t)voice, true, patch};
+    post(cmd);
+}
+
+void PcmSynth::noteOff(int voice)
+{
+    if (voice < 0 || voice >= SYNTH_VOICES)
+        return;
+    Command cmd = {(uint8_t)voice, false, SynthPatch()};
+    post(cmd);
+}
+
+void PcmSynth::allNotesOff()
+{
+    Command cmd = {(uint8_t)SYNTH_VOICES, false, SynthPatch()};
+    post(cmd);
+}
+
+// Dropped if the renderer is 16 commands behind
+void PcmSynth::post(const Command &cmd)
+{
+    uint8_t head = queueHead.load(std::memory_order_relaxed);
+    uint8_t next = (head + 1) & (SYNTH_QUEUE_SIZE - 1);
+    if (next == queueTail.load(std::memory_order_acquire))
+        return;
+    queue[head] = cmd;
+    queueHead.store(next, std::memory_order_release);
+}
+
+// --- Consumer ---
+
+int PcmSynth::render()
+{
+    int rendered = 0;
+    uint32_t written = blocksWritten.load(std::memory_order_relaxed);
+    while (written - blocksRead.load(std::memory_order_acquire) < (uint32_t)SYNTH_RING_BLOCKS)
+    {
+        applyCommands(); // Per block: commands land within 16 ms
+        renderBlock(ring[written & (SYNTH_RING_BLOCKS - 1)]);
+        blocksWritten.store(++written, std::memory_order_release);
+        rendered++;
+    }
+    return rendered;
+}
+
+const int16_t *PcmSynth::frontBlock() const
+{
+    uint32_t read = blocksRead.load(std::memory_order_relaxed);
+    if (read == blocksWritten.load(std::memory_order_acquire))
+        return NULL;
+    return ring[read & (SYNTH_RING_BLOCKS - 1)];
+}
+
+void PcmSynth::popBlock()
+{
+    uint32_t read = blocksRead.load(std::memory_order_relaxed);
+    if (read != blocksWritten.load(std::memory_order_acquire))
+        blocksRead.store(read + 1, std::memory_order_release);
+}
+
+void PcmSynth::applyCommands()
+{
+    uint8_t tail = queueTail.load(std::memory_order_relaxed);
+    while (tail != queueHead.load(std::memory_order_acquire))
+    {
+        const Command &cmd = queue[tail];
+        if (cmd.voice == SYNTH_VOICES)
+        {
+            for (int v = 0; v < SYNTH_VOICES; ++v)
+                oscillators[v].active = false;
+        }
+        else if (cmd.on)
+            start(oscillators[cmd.voice], cmd.patch);
+        else
+            oscillators[cmd.voice].active = false;
+        tail = (tail + 1) & (SYNTH_QUEUE_SIZE - 1);
+        queueTail.store(tail, std::memory_order_release);
+    }
+}
+
+// Converts a patch into per-sample steps, so the inner loop only adds
+void PcmSynth::start(Oscillator &osc, const SynthPatch &patch)
+{
+    osc.waveform = patch.waveform;
+    osc.phase = 0;
+    osc.increment = phaseIncrement(patch.startFreq);
+    osc.level = (int32_t)patch.startLevel << 8;
+    osc.remaining = (uint32_t)patch.duration * SYNTH_SAMPLE_RATE / 1000;
+    if (osc.remaining > 0)
+    {
+        int64_t sweep = (int64_t)phaseIncrement(patch.endFreq) - osc.increment;
+        osc.incrementDelta = (int32_t)(sweep / (int64_t)osc.remaining);
+        osc.levelDelta = (((int32_t)patch.endLevel - patch.startLevel) << 8) / (int32_t)osc.remaining;
+    }
+    else
+    {
+        osc.incrementDelta = 0;
+        osc.levelDelta = 0;
+    }
+    osc.active = true;
+}
+
+void PcmSynth::renderBlock(int16_t *out)
+{
+    int32_t mix[SYNTH_BLOCK_SAMPLES];
+    memset(mix, 0, sizeof(mix));
+
+    for (int v = 0; v < SYNTH_VOICES; ++v)
+    {
+        Oscillator &osc = oscillators[v];
+        if (!osc.active)
+            continue;
+        int n = SYNTH_BLOCK_SAMPLES;
+        if (osc.remaining > 0 && osc.remaining < (uint32_t)n)
+            n = (int)osc.remaining;
+
+        // Locals keep the oscillator in registers across the loop
+        uint32_t phase = osc.phase, increment = osc.increment;
+        int32_t level = osc.level;
+        for (int i = 0; i < n; ++i)
+        {
+            int32_t sample;
+            switch (osc.waveform)
+            {
+            case WAVE_SINE:
+                sample = sinQ15((BAngle)(phase >> 16));
+                break;
+            case WAVE_SQUARE:
+                sample = (phase & 0x80000000u) ? -32767 : 32767;
+                break;
+            case WAVE_TRIANGLE:
+            {
+                int32_t ramp = (int32_t)(phase >> 16) - 32768; // -32768..32767
+                sample = 32767 - 2 * (ramp < 0 ? -ramp : ramp);
+                break;
+            }
+            default: // WAVE_NOISE: sample-and-hold of a Galois LFSR
+                if (phase < increment) // Wrapped this sample
+                {
+                    osc.noiseState = (osc.noiseState >> 1) ^ (-(int32_t)(osc.noiseState & 1) & 0xB400u);
+                    osc.noiseSample = (int16_t)osc.noiseState;
+                }
+                sample = osc.noiseSample;
+                break;
+            }
+            mix[i] += (sample * (level >> 8)) >> 15;
+            phase += increment;
+            increment += osc.incrementDelta;
+            level += osc.levelDelta;
+        }
+        osc.phase = phase;
+        osc.increment = increment;
+        osc.level = level;
+        if (osc.remaining > 0)
+        {
+            osc.remaining -= n;
+            if (osc.remaining == 0)
+                osc.active = false;
+        }
+    }
+
+    for (int i = 0; i < SYNTH_BLOCK_SAMPLES; ++i)
+    {
+        int32_t s = mix[i] >> SYNTH_MIX_SHIFT;
+        out[i] = (int16_t)(s > 32767 ? 32767 : (s < -32768 ? -32768 : s));
+    }
+}
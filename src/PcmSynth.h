@@ -0,0 +1,86 @@
+#ifndef PCM_SYNTH_H
+#define PCM_SYNTH_H
+
+#include <Arduino.h>
+#include <atomic>
+
+// --- Software Synthesizer ---
+// A small DDS oscillator bank (sine from the FastTrig wavetable) mixed in
+// Q15 fixed point into a ring of DMA-sized 16-bit mono blocks, for an I2S
+// DAC or the ESP32's built-in DAC instead of the square-wave buzzer. All
+// state is preallocated: rendering a block allocates nothing and takes no
+// locks.
+//
+// Threads: noteOn()/noteOff() come from one producer (the audio sequencer);
+// render() and the block reads run on one consumer (the output task).
+
+const uint32_t SYNTH_SAMPLE_RATE = 16000;
+const int SYNTH_BLOCK_SAMPLES = 256; // 16 ms per block at 16 kHz
+const int SYNTH_RING_BLOCKS = 4;     // Power of two
+const int SYNTH_VOICES = 4;
+const int SYNTH_QUEUE_SIZE = 16;     // Power of two
+
+enum SynthWaveform : uint8_t { WAVE_SINE, WAVE_SQUARE, WAVE_TRIANGLE, WAVE_NOISE };
+
+// One sound: a frequency sweep under a linear level ramp. WAVE_NOISE
+// draws a new random sample at the oscillator frequency, so low
+// frequencies rumble and high ones hiss.
+struct SynthPatch {
+    SynthWaveform waveform;
+    uint16_t startFreq;  // Hz
+    uint16_t endFreq;    // Hz, reached at the end of `duration`
+    uint16_t duration;   // ms; 0 = until noteOff()
+    int16_t startLevel;  // Q15
+    int16_t endLevel;    // Q15
+};
+
+class PcmSynth {
+public:
+    PcmSynth();
+
+    // --- Producer ---
+    void noteOn(int voice, const SynthPatch &patch); // Restarts the voice
+    void noteOff(int voice);
+    void allNotesOff();
+
+    // --- Consumer ---
+    // Renders into every free ring block; returns how many were filled
+    int render();
+    // Oldest rendered block, or NULL if the ring is empty. Valid until popBlock().
+    const int16_t *frontBlock() const;
+    void popBlock();
+
+private:
+    struct Oscillator {
+        SynthWaveform waveform;
+        uint32_t phase;         // Full turn = 2^32
+        uint32_t increment;     // Phase step per sample
+        int32_t incrementDelta; // Sweep: added to increment every sample
+        int32_t level;          // Q15 << 8, so short ramps still move
+        int32_t levelDelta;
+        uint32_t remaining;     // Samples left; 0 = held
+        uint32_t noiseState;
+        int16_t noiseSample;
+        bool active;
+    };
+    struct Command {
+        uint8_t voice; // SYNTH_VOICES = all
+        bool on;
+        SynthPatch patch;
+    };
+
+    Oscillator oscillators[SYNTH_VOICES];
+    int16_t ring[SYNTH_RING_BLOCKS][SYNTH_BLOCK_SAMPLES];
+    std::atomic<uint32_t> blocksWritten;
+    std::atomic<uint32_t> blocksRead;
+    Command queue[SYNTH_QUEUE_SIZE];
+    std::atomic<uint8_t> queueHead;
+    std::atomic<uint8_t> queueTail;
+
+    void post(const Command &cmd);
+    void applyCommands();
+    void start(Oscillator &osc, const SynthPatch &patch);
+    void renderBlock(int16_t *out);
+};
+
+#endif // PCM_SYNTH_H
@@ -0,0 +1,140 @@
+#ifndef SAVE_STATE_H
+#define SAVE_STATE_H
+
+#include <Arduino.h>
+#include "AstroConfig.h"
+#include "EntityPool.h"
+#include "FastRandom.h"
+
+// --- Save States ---
+// Everything the simulation carries between ticks, as one fixed-size,
+// trivially copyable record: BasicAstroLib::saveState() and loadState()
+// are plain field copies with no allocation, so a state can be taken every
+// tick (rollback) or kept in RAM/flash (instant resume). A state only loads
+// into the build that saved it: same Config and numeric mode, checked via
+// `layout`. A CRC over the record and range checks on everything used as an
+// index turn a torn or corrupt copy (flash-backed resume) into a refused
+// load. Particles are cosmetic and not included.
+const uint8_t SAVE_STATE_MAGIC = 'S';
+const uint8_t SAVE_STATE_VERSION = 2;
+
+// Bits of BasicSaveState::flags
+const uint8_t SAVE_SHIP_ACTIVE = 0x01;
+const uint8_t SAVE_FIRE_LATCHED = 0x02;
+const uint8_t SAVE_HYPERSPACE_LATCHED = 0x04;
+const uint8_t SAVE_FIRE_HELD = 0x08;       // Button down on the last tick (edge detection)
+const uint8_t SAVE_HYPERSPACE_HELD = 0x10;
+
+// CRC-32 (IEEE), the same sum as Leaderboard::crc32, table-driven so a
+// state can still be sealed every tick
+uint32_t saveStateCrc(const uint8_t *data, size_t length);
+
+template <typename Config>
+struct BasicSaveState {
+    // Zeroed once, so padding never differs between two saves of the same game
+    BasicSaveState() { memset((void *)this, 0, sizeof(*this)); }
+
+    uint32_t crc;    // CRC-32 of every byte after it; seal() after editing a field
+    uint8_t magic;
+    uint8_t version;
+    uint8_t state;   // GameState
+    uint8_t flags;   // SAVE_* bits
+    uint32_t layout; // layoutId() of the saving build
+
+    // Timers (sim clock, ms). Fixed 32-bit, like millis() on the ESP32, so
+    // the record has the same layout on 64-bit hosts
+    uint32_t simBaseTime;
+    uint32_t lastFireTime;
+    uint32_t shipSpawnTime;
+    uint32_t lastHyperspaceTime;
+    uint32_t waveClearTime;
+
+    // Counters
+    uint32_t tickCount;
+    uint32_t tickAccumulator;
+    int32_t score;
+    int32_t lives;
+    int32_t highScore;
+    int32_t shipLifetime;
+    uint16_t tickRate;
+    BAngle shipAngle;
+    BAngle prevShipAngle;
+    uint16_t reserved;
+
+    // Ship
+    Scalar shipX, shipY;
+    Scalar shipVelX, shipVelY;
+    Scalar prevShipX, prevShipY; // Start of the current tick (interpolation)
+    Scalar shipRadius;
+
+    FastRandom rng;
+    FastRandom particleRng;
+    EntityPool<Config::MAX_BULLETS> bullets;
+    EntityPool<Config::MAX_ASTEROIDS> asteroids;
+    AsteroidMesh asteroidMeshes[Config::MAX_ASTEROIDS];
+
+    void seal() { crc = payloadCrc(); }
+
+    // Sealed by this build and every index in range: safe to load
+    bool valid() const
+    {
+        if (crc != payloadCrc() || magic != SAVE_STATE_MAGIC || version != SAVE_STATE_VERSION || layout != layoutId())
+            return false;
+        if (state > WAVE_CLEAR || lives < 0 || lives > 3 || score < 0 || tickRate == 0 ||
+            tickAccumulator >= (uint32_t)TICK_UNIT || !onScreen(shipX, shipY))
+            return false;
+        if (!bullets.consistent() || !asteroids.consistent())
+            return false;
+        for (int i = bullets.first(); i >= 0; i = bullets.next(i))
+            if (!onScreen(bullets.posX[i], bullets.posY[i]))
+                return false;
+        for (int i = asteroids.first(); i >= 0; i = asteroids.next(i))
+        {
+            int size = asteroids.size[i];
+            int vertices = asteroidMeshes[i].vertexCount;
+            if (!onScreen(asteroids.posX[i], asteroids.posY[i]) || vertices < 3 || vertices > MAX_ASTEROID_VERTICES ||
+                (size != ASTEROID_SIZE_SMALL && size != ASTEROID_SIZE_MEDIUM && size != ASTEROID_SIZE_LARGE))
+                return false;
+        }
+        return true;
+    }
+
+    // Differs between builds whose states are not interchangeable
+    static uint32_t layoutId()
+    {
+#if defined(ASTRO_FIXED_POINT)
+        const uint32_t fixedPoint = 1;
+#else
+        const uint32_t fixedPoint = 0;
+#endif
+        return (uint32_t)sizeof(BasicSaveState) ^ ((uint32_t)Config::WIDTH << 12) ^ ((uint32_t)Config::HEIGHT << 20) ^
+               (fixedPoint << 31);
+    }
+
+private:
+    uint32_t payloadCrc() const
+    {
+        const uint8_t *payload = (const uint8_t *)(&crc + 1);
+        return saveStateCrc(payload, (const uint8_t *)this + sizeof(*this) - payload);
+    }
+
+    // Collision cells and wrapped drawing index by position
+    static bool onScreen(Scalar x, Scalar y) { return x >= 0 && x < Config::WIDTH && y >= 0 && y < Config::HEIGHT; }
+};
+
+// --- Delta Encoding ---
+// Encodes `current` against `previous` (two states, or any two equal-sized
+// blobs) as runs: a varint count of unchanged bytes, a varint count of
+// changed bytes, then those bytes XORed with `previous`. Consecutive ticks
+// change a small part of a state, so a delta is usually a fraction of its
+// size. XOR makes a delta work both ways: applied to `previous` it gives
+// `current`, applied to `current` it gives `previous`.
+//
+// encodeStateDelta() returns the bytes written, or 0 if `capacity` is too
+// small; maxStateDeltaSize() is always enough. applyStateDelta() returns
+// false on a damaged delta.
+inline size_t maxStateDeltaSize(size_t size) { return 2 * size + 8; }
+size_t encodeStateDelta(const void *previous, const void *current, size_t size, uint8_t *out, size_t capacity);
+bool applyStateDelta(const void *base, const uint8_t *delta, size_t deltaSize, void *out, size_t size);
+
+#endif // SAVE_STATE_H